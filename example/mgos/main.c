@@ -18,8 +18,14 @@ struct app_data {
   struct mgos_ssd1306* display;
   double last_draw_time;
   uint32_t update_num;
+  struct pi_decode_cache pi_cache;
+  struct local_time_cache time_cache;
 };
 
+// The mgos_si470x tuner is configured for the US (which is also why mos.yml
+// builds rds_util with RDS_UTIL_PTY_RBDS_ONLY).
+static const enum si470x_region_t kRegion = REGION_US;
+
 const int kFixedFont = 0;
 const int kVariableFont = 1;
 const int kStatusHeight = 16;
@@ -113,9 +119,7 @@ static void UpdateDisplayCb(void* arg) {
   rt[ARRAY_SIZE(rt) - 1] = '\0';
   TrimTrailingWhitespace(rt);
 
-  char picode[40];
-  if (!decode_pi_code(picode, ARRAY_SIZE(picode), rds->pi_code, REGION_US))
-    picode[0] = '\0';
+  const char* picode = decode_rds_pi_code_cached(&app->pi_cache, rds, kRegion);
 
   int y = 0;
   char buff[80];
@@ -143,7 +147,7 @@ static void UpdateDisplayCb(void* arg) {
 
   {
     mgos_ssd1306_draw_string(app->display, 0, y,
-                             get_pty_code_name(rds->pty, REGION_US));
+                             get_pty_code_name(rds->pty, kRegion));
     const int kDbWidth = 30;
     snprintf(buff, kBuffSize, "%d Db", state.rssi);
     mgos_ssd1306_draw_string(app->display, width - kDbWidth, y, buff);
@@ -221,19 +225,17 @@ static void LogStateCb(void* arg) {
   ptyn[ARRAY_SIZE(ptyn) - 1] = '\0';
   TrimTrailingWhitespace(ptyn);
 
-  char picode[40];
-  if (!decode_pi_code(picode, ARRAY_SIZE(picode), rds->pi_code, REGION_US)) {
-    picode[0] = '\0';
-  }
+  const char* picode = decode_rds_pi_code_cached(&app->pi_cache, rds, kRegion);
 
   LOG(LL_INFO, ("%.1f MHz (%s)@%d, PS:\"%s\" PTYN:\"%s\"",
                 state.frequency / 1e6, picode, state.rssi, ps, ptyn));
+  LOG(LL_DEBUG, ("     PI cache: %u hits, %u misses", app->pi_cache.hits,
+                 app->pi_cache.misses));
   if (HasAnyText(rt))
     LOG(LL_INFO, ("     RT:\"%s\"", rt));
   if (ContainsTime(rds)) {
-    char buffer[40];
-    format_local_time(buffer, ARRAY_SIZE(buffer), rds);
-    LOG(LL_INFO, ("     Clock: %s", buffer));
+    LOG(LL_INFO, ("     Clock: %s",
+                  format_local_time_cached(&app->time_cache, rds)));
   }
 }
 
@@ -0,0 +1,88 @@
+// The ODA decoder state shared by the tuner's RDS callbacks, which decode
+// groups into it, and the UI, which draws snapshots of it.
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+
+#include <oda_decode.h>
+#include <si470x.h>
+
+// The ODA state and the RDS data it was decoded with, so the RT+ tags index
+// the RadioText which they were received with.
+struct DecoderSnapshot {
+  struct rds_oda_data oda;
+  struct rds_data rds;   // Zeroed if published without RDS data.
+  uint32_t generation;   // Number of DecoderState::Update() calls.
+  uint32_t tag_changes;  // Number of those which changed RT+/iTunes tags.
+};
+
+// A single producer, single consumer triple buffer. The tuner's callbacks
+// (the producer) decode into state which only they touch, then publish a
+// copy of it to a spare buffer. The UI (the consumer) takes the latest
+// published buffer. The two only share an atomic buffer index, so neither
+// ever waits for the other, and the callbacks may be called with the tuner's
+// lock held.
+class DecoderState {
+ public:
+  DecoderState() : oda_(create_oda_data()) {
+    for (DecoderSnapshot& buffer : buffers_) {
+      buffer.oda = *oda_;
+      memset(&buffer.rds, 0, sizeof(buffer.rds));
+      buffer.generation = 0;
+      buffer.tag_changes = 0;
+    }
+  }
+  ~DecoderState() { delete_oda_data(oda_); }
+
+  DecoderState(const DecoderState&) = delete;
+  DecoderState& operator=(const DecoderState&) = delete;
+
+  // Producer: call |fn| with the ODA state to modify it (e.g. decode a
+  // group), then publish it with |rds|, the RDS data it was decoded with.
+  template <typename Fn>
+  void Update(Fn fn, const struct rds_data* rds) {
+    fn(oda_);
+    generation_++;
+    if (consume_oda_tag_changes(&oda_->rtplus) |
+        consume_oda_tag_changes(&oda_->itunes)) {
+      tag_changes_++;
+    }
+    DecoderSnapshot* back = &buffers_[back_];
+    back->oda = *oda_;
+    if (rds)
+      back->rds = *rds;
+    else
+      memset(&back->rds, 0, sizeof(back->rds));
+    back->generation = generation_;
+    back->tag_changes = tag_changes_;
+    back_ = middle_.exchange(back_ | kFresh, std::memory_order_acq_rel) &
+            kIndexMask;
+  }
+
+  // Consumer: the latest published snapshot. It is not written until the
+  // next call.
+  const DecoderSnapshot& Snapshot() {
+    if (middle_.load(std::memory_order_relaxed) & kFresh) {
+      front_ =
+          middle_.exchange(front_, std::memory_order_acq_rel) & kIndexMask;
+    }
+    return buffers_[front_];
+  }
+
+ private:
+  static const uint8_t kIndexMask = 3;
+  static const uint8_t kFresh = 4;  // Set in |middle_| when published.
+
+  DecoderSnapshot buffers_[3];
+  struct rds_oda_data* oda_;  // Producer only.
+  uint32_t generation_ = 0;   // Producer only.
+  uint32_t tag_changes_ = 0;  // Producer only.
+  uint8_t back_ = 0;          // Producer only: the buffer being written.
+  uint8_t front_ = 1;         // Consumer only: the buffer being read.
+  // The buffer last published (or given back by the consumer).
+  std::atomic<uint8_t> middle_{2};
+};
@@ -0,0 +1,67 @@
+// Convert RDS Spy logs to binary RDS captures (see rds_capture.h).
+//
+// Captures are less than half the size of the logs they are converted from,
+// and load without parsing. The group timestamps are kept if the log has
+// them.
+
+#include <stdio.h>
+
+#include <rds_capture.h>
+#include <rds_spy_reader.h>
+
+namespace {
+
+// Convert |log_fname| to |capture_fname|. Returns the program exit code.
+int Convert(const char* log_fname, const char* capture_fname) {
+  struct rds_spy_log* log = open_rds_spy_log(log_fname);
+  if (!log) {
+    fprintf(stderr, "Can't read \"%s\"\n", log_fname);
+    return 2;
+  }
+  struct rds_spy_cursor cursor;
+  init_rds_spy_cursor(log, &cursor);
+  struct rds_blocks blocks;
+  int64_t time = 0;
+  // The capture is timed if the first group has a timestamp.
+  const bool have_group = next_rds_spy_blocks(&cursor, &blocks);
+  const bool timed = have_group && get_rds_spy_time(&cursor, &time);
+  if (!have_group) {
+    fprintf(stderr, "\"%s\" has no groups\n", log_fname);
+    close_rds_spy_log(log);
+    return 2;
+  }
+
+  struct rds_capture_writer* writer =
+      create_rds_capture_writer(capture_fname, timed);
+  if (!writer) {
+    perror(capture_fname);
+    close_rds_spy_log(log);
+    return 3;
+  }
+  size_t num_groups = 0;
+  bool ok = true;
+  do {
+    // Groups without a timestamp are given the time of the one before.
+    if (timed)
+      get_rds_spy_time(&cursor, &time);
+    ok = write_rds_capture_group(writer, &blocks, time);
+    num_groups++;
+  } while (ok && next_rds_spy_blocks(&cursor, &blocks));
+  close_rds_spy_log(log);
+  if (!close_rds_capture_writer(writer) || !ok) {
+    fprintf(stderr, "Unable to write \"%s\"\n", capture_fname);
+    return 3;
+  }
+  printf("%s: %zu groups%s\n", log_fname, num_groups, timed ? " (timed)" : "");
+  return 0;
+}
+
+}  // namespace
+
+int main(int argc, const char** argv) {
+  if (argc != 3) {
+    fprintf(stderr, "usage: %s <RDS Spy log> <capture file>\n", argv[0]);
+    return 1;
+  }
+  return Convert(argv[1], argv[2]);
+}
@@ -1,21 +1,35 @@
 #include <curses.h>
 #include <dirent.h>
+#include <errno.h>
+#include <poll.h>
+#include <stdarg.h>
+#include <stdio.h>
 #include <string.h>
+#include <sys/eventfd.h>
 #include <sys/stat.h>
+#include <sys/timerfd.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <vector>
 
 #include <oda_decode.h>
-#include <rds_spy_log_reader.h>
+#include <rds_capture.h>
+#include <rds_spy_reader.h>
 #include <rds_util.h>
 #include <si470x.h>
 #include <si470x_port.h>
+#include <tmc_events.h>
+
+#include "decoder_state.h"
 
 namespace {
 
@@ -25,13 +39,19 @@ struct WindowEnder {
   ~WindowEnder() { endwin(); }
 };
 
-struct RDSTestData {
-  std::string fname;                      // File name.
-  std::vector<struct rds_blocks> blocks;  // RDS block data in file.
+struct FdCloser {
+  explicit FdCloser(int fd) : fd(fd) {}
+  ~FdCloser() {
+    if (fd != -1)
+      close(fd);
+  }
+  const int fd;
 };
 
-// Sleep for N msecs in main loop.
-constexpr auto kSleepDuration = std::chrono::milliseconds(5);
+struct RDSTestData {
+  std::string fname;  // File name.
+  off_t size;         // File size (bytes).
+};
 
 // Update display every N secs.
 constexpr auto kUpdateInterval = std::chrono::seconds(1);
@@ -39,21 +59,330 @@ constexpr auto kUpdateInterval = std::chrono::seconds(1);
 // Seek tuner up to next station every N secs.
 constexpr auto kTuneInterval = std::chrono::seconds(5);
 
+// Max. number of TMC messages shown on the basic page.
+constexpr uint8_t kMaxTMCLines = 5;
+
+// Default limit on the RDS test data held in memory (see --cache-mb).
+constexpr size_t kDefaultCacheMB = 256;
+
+// When replaying, give up waiting for the remaining groups of a file if none
+// are decoded for this long.
+constexpr auto kReplayStallTimeout = std::chrono::seconds(1);
+
+// The text of each screen row. A frame is built with Print() etc. and then
+// Flush() repaints only those rows which differ from the last frame, so a
+// frame in which one RadioText character changed costs one row.
+class ScreenModel {
+ public:
+  // Start a new (empty) frame.
+  void Clear() {
+    for (std::string& row : rows_)
+      row.clear();
+  }
+
+  // Write text at row |y|, column |x| (like mvprintw).
+  void Write(int y, size_t x, const char* fmt, va_list args) {
+    if (y < 0)
+      return;
+    char text[256];
+    const int len = vsnprintf(text, sizeof(text), fmt, args);
+    if (len <= 0)
+      return;
+    std::string& row = GetRow(y);
+    if (row.size() < x)
+      row.resize(x, ' ');
+    row.replace(x, std::min<size_t>(len, sizeof(text) - 1), text);
+  }
+
+  // Write text following the existing text of row |y| (like printw).
+  void Append(int y, const char* fmt, ...)
+      __attribute__((format(printf, 3, 4))) {
+    va_list args;
+    va_start(args, fmt);
+    Write(y, GetRow(y).size(), fmt, args);
+    va_end(args);
+  }
+
+  // Fill row |y| with |ch| (like hline).
+  void HLine(int y, char ch) { GetRow(y).assign(COLS, ch); }
+
+  // Forget the last frame so that the next Flush() repaints every row.
+  void Invalidate() { drawn_.clear(); }
+
+  // Repaint the changed rows and refresh the terminal.
+  void Flush() {
+    const size_t num_rows = std::max(rows_.size(), drawn_.size());
+    rows_.resize(num_rows);
+    drawn_.resize(num_rows, std::string(1, '\0'));  // Differs from any row.
+    for (size_t y = 0; y < num_rows && y < static_cast<size_t>(LINES); y++) {
+      if (rows_[y] == drawn_[y])
+        continue;
+      mvaddnstr(y, 0, rows_[y].c_str(), COLS);
+      clrtoeol();
+      repaint_cnt_++;
+    }
+    rows_.swap(drawn_);
+    refresh();
+  }
+
+  // # of rows repainted.
+  uint32_t repaint_cnt() const { return repaint_cnt_; }
+
+ private:
+  std::string& GetRow(int y) {
+    if (y >= static_cast<int>(rows_.size()))
+      rows_.resize(y + 1);
+    return rows_[y];
+  }
+
+  std::vector<std::string> rows_;   // The frame being built.
+  std::vector<std::string> drawn_;  // The frame on the screen.
+  uint32_t repaint_cnt_ = 0;
+};
+
+// The blocks of the RDS test files, loaded on demand. Getting a file loads it
+// (unless already loaded) and starts prefetching the files either side of it
+// in the background. When more than the memory cap is loaded, the least
+// recently used files are evicted, though never the current file or its
+// neighbours.
+class TestDataCache {
+ public:
+  using Blocks = std::shared_ptr<const std::vector<struct rds_blocks>>;
+
+  TestDataCache(const std::vector<RDSTestData>* files, size_t memory_cap)
+      : files_(files),
+        entries_(files->size()),
+        memory_cap_(memory_cap) {
+    // A thread per neighbour, up to the number of cores, so that both
+    // neighbours of a file load at once.
+    const unsigned num_threads =
+        std::max(1u, std::min(2u, std::thread::hardware_concurrency()));
+    for (unsigned i = 0; i < num_threads; i++)
+      threads_.emplace_back(&TestDataCache::PrefetchFiles, this);
+  }
+
+  ~TestDataCache() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    for (std::thread& thread : threads_)
+      thread.join();
+  }
+
+  // Get the blocks of file |idx|, loading them if necessary. Returns null
+  // (with the reason in |error|) if the file can't be loaded.
+  Blocks Get(size_t idx, std::string* error) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const size_t num_files = entries_.size();
+    const size_t next = (idx + 1) % num_files;
+    const size_t prev = (idx + num_files - 1) % num_files;
+    pinned_ = {idx, next, prev};
+    Entry& entry = entries_[idx];
+    entry.last_used = ++use_cnt_;
+    cv_.wait(lock, [&entry] { return !entry.loading; });
+    if (entry.blocks)
+      hit_cnt_++;
+    else if (!entry.error)
+      LoadFile(idx, &lock);
+    Blocks blocks = entry.blocks;
+    if (!blocks) {
+      const std::string& fname = (*files_)[idx].fname;
+      *error = entry.error == kEmpty ? '"' + fname + "\" is empty"
+                                     : "Can't read \"" + fname + '"';
+    }
+    prefetch_ = {next, prev};
+    lock.unlock();
+    cv_.notify_all();
+    return blocks;
+  }
+
+  struct Stats {
+    size_t files;    // # of files loaded.
+    size_t bytes;    // Size of the loaded blocks.
+    uint32_t hits;   // # of Get() calls for an already loaded file.
+    uint32_t loads;  // # of files loaded (including prefetches).
+  };
+
+  Stats GetStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = {0, loaded_bytes_, hit_cnt_, load_cnt_};
+    for (const Entry& entry : entries_) {
+      if (entry.blocks)
+        stats.files++;
+    }
+    return stats;
+  }
+
+  // Error codes (which are also the program's exit codes).
+  enum { kUnreadable = 2, kEmpty = 3 };
+
+ private:
+  struct Entry {
+    Blocks blocks;           // Null unless loaded.
+    int error = 0;           // Set if the file failed to load.
+    bool loading = false;    // Being loaded (with the lock released).
+    uint64_t last_used = 0;  // |use_cnt_| when last used.
+  };
+
+  static size_t GetSize(const Blocks& blocks) {
+    return blocks->size() * sizeof(struct rds_blocks);
+  }
+
+  // Copy the groups of a binary capture (which needs no parsing), or else
+  // decode an RDS Spy log straight from the mapped file. The vector is sized
+  // once, by line count, so it is never regrown (or copied) while loading.
+  static bool LoadBlocks(const char* fname,
+                         std::vector<struct rds_blocks>* blocks) {
+    struct rds_capture* capture = open_rds_capture(fname);
+    if (capture) {
+      blocks->resize(get_rds_capture_num_groups(capture));
+      read_rds_capture_blocks(capture, 0, blocks->data(), blocks->size());
+      close_rds_capture(capture);
+      return true;
+    }
+    struct rds_spy_log* log = open_rds_spy_log(fname);
+    if (!log)
+      return false;
+    blocks->resize(get_rds_spy_log_max_groups(log));
+    struct rds_spy_cursor cursor;
+    init_rds_spy_cursor(log, &cursor);
+    blocks->resize(
+        read_rds_spy_blocks(&cursor, blocks->data(), blocks->size()));
+    close_rds_spy_log(log);
+    return true;
+  }
+
+  // Load file |idx|. The lock is released while the file is read.
+  void LoadFile(size_t idx, std::unique_lock<std::mutex>* lock) {
+    Entry& entry = entries_[idx];
+    entry.loading = true;
+    lock->unlock();
+    auto blocks = std::make_shared<std::vector<struct rds_blocks>>();
+    int error = 0;
+    if (!(*files_)[idx].size)
+      error = kEmpty;
+    else if (!LoadBlocks((*files_)[idx].fname.c_str(), blocks.get()))
+      error = kUnreadable;
+    else if (blocks->empty())
+      error = kEmpty;
+    lock->lock();
+    entry.loading = false;
+    entry.error = error;
+    load_cnt_++;
+    if (!error) {
+      entry.blocks = std::move(blocks);
+      loaded_bytes_ += GetSize(entry.blocks);
+      Evict();
+    }
+    cv_.notify_all();
+  }
+
+  // Evict the least recently used unpinned files until no more than
+  // |memory_cap_| is loaded. The pinned files may exceed the cap on their own.
+  void Evict() {
+    while (loaded_bytes_ > memory_cap_) {
+      Entry* lru = nullptr;
+      for (size_t i = 0; i < entries_.size(); i++) {
+        Entry& entry = entries_[i];
+        if (!entry.blocks ||
+            std::find(pinned_.begin(), pinned_.end(), i) != pinned_.end()) {
+          continue;
+        }
+        if (!lru || entry.last_used < lru->last_used)
+          lru = &entry;
+      }
+      if (!lru)
+        return;
+      loaded_bytes_ -= GetSize(lru->blocks);
+      lru->blocks.reset();
+    }
+  }
+
+  // A prefetch thread. Each takes the next file from |prefetch_|.
+  void PrefetchFiles() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      cv_.wait(lock, [this] { return stop_ || !prefetch_.empty(); });
+      if (stop_)
+        return;
+      const size_t idx = prefetch_.front();
+      prefetch_.erase(prefetch_.begin());
+      Entry& entry = entries_[idx];
+      if (entry.blocks || entry.loading || entry.error)
+        continue;
+      // As recent as the current file, so older files are evicted first.
+      entry.last_used = use_cnt_;
+      LoadFile(idx, &lock);
+    }
+  }
+
+  const std::vector<RDSTestData>* files_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<Entry> entries_;    // Indexed as |files_|.
+  std::vector<size_t> prefetch_;  // Files to prefetch, in order.
+  const size_t memory_cap_;       // Max. size of the loaded blocks.
+  size_t loaded_bytes_ = 0;       // Size of the loaded blocks.
+  // The file last given to Get() (which is displayed) and the neighbours
+  // being prefetched, which are never evicted.
+  std::vector<size_t> pinned_;
+  uint64_t use_cnt_ = 0;
+  uint32_t hit_cnt_ = 0;
+  uint32_t load_cnt_ = 0;
+  bool stop_ = false;
+  std::vector<std::thread> threads_;  // Prefetch threads.
+};
+
 struct si470x_t* g_tuner;
-struct rds_oda_data* g_oda_data;
+// Decoded by the RDS callbacks, and drawn from g_snapshot.
+DecoderState g_decoder_state;
+// The UI's ODA snapshot and RDS data, both read at the start of each Draw().
+const DecoderSnapshot* g_snapshot;
+struct rds_data g_rds_data;
+struct pi_decode_cache g_pi_cache;
+enum si470x_region_t g_region;  // The region the tuner is configured for.
+struct local_time_cache g_time_cache;
 std::atomic<bool> g_dirty;
+int g_rds_event_fd = -1;  // eventfd signalled when RDS data changes.
 int g_update_num;
+uint32_t g_wakeup_cnt;  // # of times the main loop has woken.
+std::chrono::steady_clock::time_point g_loop_start;
 DrawMode g_draw_mode = DrawMode::Basic;
-std::vector<RDSTestData> g_rds_test_data;
+bool g_replay;  // Replaying test data as fast as possible, without a display.
+std::vector<RDSTestData> g_rds_test_data;  // The test file index.
+std::unique_ptr<TestDataCache> g_test_data_cache;
+// The blocks being played. Held until the tuner is powered off.
+TestDataCache::Blocks g_current_blocks;
 size_t g_current_block_idx = 0;
 WINDOW* g_window;
+ScreenModel g_screen;
+uint64_t g_loop_start_bytes;  // GetThreadBytesWritten() at g_loop_start.
+
+// Draw text at row |y|, column |x| of the next frame.
+void DrawText(int y, int x, const char* fmt, ...)
+    __attribute__((format(printf, 3, 4)));
+void DrawText(int y, int x, const char* fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  g_screen.Write(y, x, fmt, args);
+  va_end(args);
+}
+
+// RT+ and iTunes tag lines as last drawn, and the tag change count and
+// RadioText they were built from. These are only rebuilt when a tag or the
+// RadioText changes.
+std::vector<std::string> g_rtplus_lines;
+uint32_t g_rtplus_tag_changes;
+char g_rtplus_rt_a[sizeof(rds_rt::display)];
+char g_rtplus_rt_b[sizeof(rds_rt::display)];
+int g_rtplus_rebuild_cnt;
 
 struct TunerDeleter {
   ~TunerDeleter() {
     if (g_tuner)
       si470x_delete(g_tuner);
-    if (g_oda_data)
-      delete_oda_data(g_oda_data);
   }
 };
 
@@ -99,50 +428,160 @@ bool ContainsTime(const struct rds_data* rds) {
 
 void OnRDSChanged(void*) {
   g_dirty = true;
+  const uint64_t one = 1;
+  const ssize_t written = write(g_rds_event_fd, &one, sizeof(one));
+  (void)written;  // Only fails if the counter is saturated.
+}
+
+// The number of bytes written by the calling thread, or 0 if unknown. The
+// main thread only writes to the terminal, so this counts the terminal output.
+uint64_t GetThreadBytesWritten() {
+  FILE* f = fopen("/proc/thread-self/io", "r");
+  if (!f)
+    return 0;
+  unsigned long long wchar = 0;
+  char line[64];
+  while (fgets(line, sizeof(line), f)) {
+    if (sscanf(line, "wchar: %llu", &wchar) == 1)
+      break;
+  }
+  fclose(f);
+  return wchar;
+}
+
+// Arm timer |fd| to expire after |interval|, and every |interval| after that
+// if |repeat|. A zero interval disarms the timer.
+template <typename Duration>
+void ArmTimer(int fd, Duration interval, bool repeat) {
+  const auto ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count();
+  struct itimerspec spec;
+  memset(&spec, 0, sizeof(spec));
+  spec.it_value.tv_sec = ns / 1000000000;
+  spec.it_value.tv_nsec = ns % 1000000000;
+  if (repeat)
+    spec.it_interval = spec.it_value;
+  timerfd_settime(fd, 0, &spec, nullptr);
 }
 
-void ClearODA(void* user_data) {
-  struct rds_oda_data* oda_data = (struct rds_oda_data*)user_data;
-  clear_oda_data(oda_data);
+// Read (and so reset) an eventfd or timerfd. Returns true if it had fired.
+bool ConsumeFd(int fd) {
+  uint64_t count;
+  return read(fd, &count, sizeof(count)) == sizeof(count);
+}
+
+void ClearODA(void*) {
+  g_decoder_state.Update(clear_oda_data, nullptr);
 }
 
 void DecodeODA(uint16_t app_id,
                const struct rds_data* rds,
                const struct rds_blocks* blocks,
                struct rds_group_type gt,
-               void* user_data) {
-  struct rds_oda_data* oda_data = (struct rds_oda_data*)user_data;
-  decode_oda_blocks(oda_data, app_id, rds, blocks, gt);
+               void*) {
+  uint32_t now;
+  if (g_replay) {
+#if defined(RDS_DEV)
+    // Virtual time: groups are 104 bits, sent at 1187.5 bits/sec. In 32
+    // bits this would overflow after 20.6M groups (three weeks of RDS).
+    now = static_cast<uint64_t>(rds->stats.data_cnt) * 104 * 2 / 2375;
+#else
+    now = 0;
+#endif
+  } else {
+    const auto time = std::chrono::steady_clock::now().time_since_epoch();
+    now = std::chrono::duration_cast<std::chrono::seconds>(time).count();
+  }
+  g_decoder_state.Update(
+      [=](struct rds_oda_data* oda_data) {
+        set_oda_time(oda_data, now);
+        decode_oda_blocks(oda_data, app_id, rds, blocks, gt);
+      },
+      rds);
+}
+
+void AppendTagLines(const char* prefix,
+                    const struct rds_oda_tags& tags,
+                    const rds_data& rds_data) {
+  for (uint64_t active = tags.active; active; active &= active - 1) {
+    const uint8_t content_type = __builtin_ctzll(active);
+    const struct rds_oda_tag* tag = find_oda_tag(&tags, content_type);
+    size_t len;
+    const char* tag_text = get_oda_tag_text(tag, &rds_data, &len);
+    char text[sizeof(rds_rt::display) + 1];
+    memcpy(text, tag_text, len);
+    MakeSpaces(text, len);
+    text[len] = '\0';
+    TrimTrailingWhitespace(text);
+    if (AllSpaces(text))
+      continue;
+    g_rtplus_lines.push_back(std::string(prefix) +
+                             get_rdsplus_code_name(content_type) + ": \"" +
+                             text + "\"");
+  }
+}
+
+// The tags are drawn from the RadioText in the snapshot they were decoded
+// with, which can change under unchanged tags.
+void UpdateRTPlusLines() {
+  const struct rds_oda_data& oda = g_snapshot->oda;
+  const struct rds_data& rds_data = g_snapshot->rds;
+  if (g_snapshot->tag_changes == g_rtplus_tag_changes &&
+      !memcmp(g_rtplus_rt_a, rds_data.rt.a.display, sizeof(g_rtplus_rt_a)) &&
+      !memcmp(g_rtplus_rt_b, rds_data.rt.b.display, sizeof(g_rtplus_rt_b))) {
+    return;
+  }
+  g_rtplus_rebuild_cnt++;
+  g_rtplus_tag_changes = g_snapshot->tag_changes;
+  memcpy(g_rtplus_rt_a, rds_data.rt.a.display, sizeof(g_rtplus_rt_a));
+  memcpy(g_rtplus_rt_b, rds_data.rt.b.display, sizeof(g_rtplus_rt_b));
+
+  g_rtplus_lines.clear();
+  AppendTagLines("RT+ ", oda.rtplus, rds_data);
+  AppendTagLines("iTunes ", oda.itunes, rds_data);
+}
+
+std::string FormatTMCMessage(const struct tmc_message& msg) {
+  struct tmc_event_info info;
+  char event[80];  // The longest event text is 73 characters.
+  char quantifier[20] = "";
+  if (get_tmc_event_info(msg.event, &info)) {
+    snprintf(event, sizeof(event), "%s", info.text);
+    if (msg.has_quantifier) {
+      format_tmc_quantifier(quantifier, sizeof(quantifier), info.quantifier,
+                            msg.quantifier);
+    }
+  } else {
+    snprintf(event, sizeof(event), "event %u", msg.event);
+  }
+  char text[128];
+  snprintf(text, sizeof(text), "%s%s%s @%u%c%u", event,
+           quantifier[0] ? ", " : "", quantifier, msg.location,
+           msg.pos_dir ? '+' : '-', msg.extent);
+  return text;
 }
 
 int DrawHeader(const si470x_state_t& state, const rds_data& rds_data) {
   if (g_rds_test_data.empty()) {
-    char picode[40];
-    if (!decode_pi_code(picode, ARRAY_SIZE(picode), rds_data.pi_code,
-                        REGION_US)) {
-      picode[0] = '\0';
-    }
-    mvprintw(0, 0, "Frequency: %.1f MHz (%s), RSSI: %d dB",
+    const char* picode =
+        decode_rds_pi_code_cached(&g_pi_cache, &rds_data, g_region);
+    DrawText(0, 0, "Frequency: %.1f MHz (%s), RSSI: %d dB",
              state.frequency / 1e6, picode, state.rssi);
   } else {
     const auto& test_data = g_rds_test_data[g_current_block_idx];
-    mvprintw(0, 0, "File %u/%d: \"%s\"", g_current_block_idx + 1,
-             g_rds_test_data.size(), test_data.fname.c_str());
+    DrawText(0, 0, "File %zu/%zu: \"%s\" (%.1f MB)", g_current_block_idx + 1,
+             g_rds_test_data.size(), test_data.fname.c_str(),
+             test_data.size / 1e6);
   }
-  move(1, 0);
-  hline('=', 200);
+  g_screen.HLine(1, '=');
   return 2;
 }
 
 void DrawCurrentState() {
-  erase();
-
   si470x_state_t state;
   if (!si470x_get_state(g_tuner, &state))
     return;
-  rds_data rds_data;
-  if (!si470x_get_rds_data(g_tuner, &rds_data))
-    return;
+  const rds_data& rds_data = g_rds_data;
 
   char ps[ARRAY_SIZE(rds_data.ps.display) + 1];
   memcpy(ps, (char*)rds_data.ps.display, sizeof(ps));
@@ -166,80 +605,69 @@ void DrawCurrentState() {
   MakeSpaces(ptyn, ARRAY_SIZE(ptyn) - 1);
   ptyn[ARRAY_SIZE(ptyn) - 1] = '\0';
 
-  char ct[40];
-  if (ContainsTime(&rds_data))
-    format_local_time(ct, ARRAY_SIZE(ct), &rds_data);
-  else
-    ct[0] = '\0';
+  const char* ct =
+      ContainsTime(&rds_data)
+          ? format_local_time_cached(&g_time_cache, &rds_data)
+          : "";
 
-  char picode[40];
-  if (!decode_pi_code(picode, ARRAY_SIZE(picode), rds_data.pi_code,
-                      REGION_US)) {
-    picode[0] = '\0';
-  }
   char manufacturer[20];
   get_manufacturer_name(state.manufacturer, manufacturer,
                         ARRAY_SIZE(manufacturer));
 
   int y = DrawHeader(state, rds_data);
-  mvprintw(y++, 0, "%s, Enabled:%c mfr:%s firmware:%d revision:%c",
+  DrawText(y++, 0, "%s, Enabled:%c mfr:%s firmware:%d revision:%c",
            get_device_name(state.device), state.enabled ? 'Y' : 'N',
            manufacturer, state.firmware, state.revision);
 
-  mvprintw(y++, 0, "Volume: %d", state.volume);
-  mvprintw(y++, 0, "Stereo: %c", state.stereo ? 'Y' : 'N');
+  DrawText(y++, 0, "Volume: %d", state.volume);
+  DrawText(y++, 0, "Stereo: %c", state.stereo ? 'Y' : 'N');
   if (rds_data.valid_values & RDS_TP_CODE ||
       rds_data.valid_values & RDS_TA_CODE) {
-    mvprintw(y++, 0, "Traffic (TP): %c, TA: %c", rds_data.tp_code ? 'Y' : 'N',
+    DrawText(y++, 0, "Traffic (TP): %c, TA: %c", rds_data.tp_code ? 'Y' : 'N',
              rds_data.ta_code ? 'Y' : 'N');
   }
   if (rds_data.valid_values & RDS_MS)
-    mvprintw(y++, 0, "M/S:  %s", rds_data.music ? "music" : "speech");
+    DrawText(y++, 0, "M/S:  %s", rds_data.music ? "music" : "speech");
   if (rds_data.valid_values & RDS_PTY)
-    mvprintw(y++, 0, "PTY:  %s", get_pty_code_name(rds_data.pty, REGION_US));
+    DrawText(y++, 0, "PTY:  %s", get_pty_code_name(rds_data.pty, g_region));
   if (rds_data.valid_values & RDS_PTYN)
-    mvprintw(y++, 0, "PTYN: [%s]", ptyn);
+    DrawText(y++, 0, "PTYN: [%s]", ptyn);
   if (rds_data.valid_values & RDS_FBT) {
-    // mvprintw(y++, 0, "FBT: [%s]", fbt);
+    // DrawText(y++, 0, "FBT: [%s]", fbt);
   }
   if (rds_data.valid_values & RDS_SLC) {
     if (rds_data.slc.variant_code == SLC_VARIANT_PAGING) {
-      mvprintw(y++, 0, "SLC:  la:%c vc:%d paging:%u cc:%u",
+      DrawText(y++, 0, "SLC:  la:%c vc:%d paging:%u cc:%u",
                rds_data.slc.la ? 'Y' : 'N', rds_data.slc.variant_code,
                rds_data.slc.data.paging.paging,
                rds_data.slc.data.paging.country_code);
     } else {
       // shortcut because all other values are just unsigned ints.
-      mvprintw(y++, 0, "SLC:  la:%c vc:%d data:0x%08x",
+      DrawText(y++, 0, "SLC:  la:%c vc:%d data:0x%08x",
                rds_data.slc.la ? 'Y' : 'N', rds_data.slc.variant_code,
                rds_data.slc.data.tmc_id);
     }
   }
   if (rds_data.valid_values & RDS_PIC) {
-    mvprintw(y++, 0, "PIN:  Day: %02d Time: %02d:%02d", rds_data.pic.day,
+    DrawText(y++, 0, "PIN:  Day: %02d Time: %02d:%02d", rds_data.pic.day,
              rds_data.pic.hour, rds_data.pic.minute);
   }
   if (rds_data.valid_values & RDS_PS)
-    mvprintw(y++, 0, "PS:   [%s]", ps);
+    DrawText(y++, 0, "PS:   [%s]", ps);
   if (rds_data.valid_values & RDS_RT) {
-    mvprintw(y++, 0, "RTA%c: \"%s\"", rds_data.rt.decode_rt == RT_A ? '*' : ' ',
+    DrawText(y++, 0, "RTA%c: \"%s\"", rds_data.rt.decode_rt == RT_A ? '*' : ' ',
              rta);
-    mvprintw(y++, 0, "RTB%c: \"%s\"", rds_data.rt.decode_rt == RT_B ? '*' : ' ',
+    DrawText(y++, 0, "RTB%c: \"%s\"", rds_data.rt.decode_rt == RT_B ? '*' : ' ',
              rtb);
-    for (int code_id = 1; code_id <= 63; code_id++) {
-      char text[ARRAY_SIZE(g_oda_data->rtplus.text[code_id]) + 1];
-      memcpy(text, (char*)g_oda_data->rtplus.text[code_id], sizeof(text));
-      MakeSpaces(text, ARRAY_SIZE(text) - 1);
-      text[ARRAY_SIZE(text) - 1] = '\0';
-      TrimTrailingWhitespace(text);
-      if (!AllSpaces(text)) {
-        const char* name = get_rdsplus_code_name(code_id);
-        move(y, 0);
-        clrtoeol();
-        move(y, 0);
-        clrtoeol();
-        mvprintw(y++, 0, "RT+ %s: \"%s\"", name, text);
-      }
+    UpdateRTPlusLines();
+    for (const std::string& line : g_rtplus_lines)
+      DrawText(y++, 0, "%s", line.c_str());
+    uint32_t cursor = g_snapshot->oda.rtplus_history.count - 1;
+    const struct rtplus_item* played =
+        get_next_rtplus_item(&g_snapshot->oda, &cursor);
+    if (played) {
+      DrawText(y++, 0, "Played: \"%s\" by \"%s\" (%us)", played->title,
+               played->artist, played->ended - played->started);
     }
   }
   for (int idx = 0; idx < NUM_TDC; idx++) {
@@ -249,45 +677,47 @@ void DrawCurrentState() {
     text[ARRAY_SIZE(text) - 1] = '\0';
     TrimTrailingWhitespace(text);
     if (!AllSpaces(text)) {
-      mvprintw(y++, 0, "TDC[%d]: \"%s\"", idx, text);
+      DrawText(y++, 0, "TDC[%d]: \"%s\"", idx, text);
     }
   }
   if (rds_data.valid_values & RDS_CLOCK)
-    mvprintw(y++, 0, "CT:   %s", ct);
+    DrawText(y++, 0, "CT:   %s", ct);
   if (rds_data.valid_values & RDS_AF)
-    mvprintw(y++, 0, "AF:   cnt=%u", rds_data.af.count);
+    DrawText(y++, 0, "AF:   cnt=%u", rds_data.af.count);
+  for (uint8_t idx = 0;
+       idx < g_snapshot->oda.tmc.message_cnt && idx < kMaxTMCLines; idx++) {
+    DrawText(y++, 0, "TMC:  %s",
+             FormatTMCMessage(g_snapshot->oda.tmc.messages[idx]).c_str());
+  }
 
   // Divider - below here is derived metrics and debug stuff.
-  move(y++, 0);
-  hline('-', 200);
+  g_screen.HLine(y++, '-');
 
   for (uint8_t idx = 0; idx < rds_data.oda_cnt; idx++) {
-    char oda_name[20];
-    get_app_name(oda_name, ARRAY_SIZE(oda_name), rds_data.oda[idx].id);
-    mvprintw(y++, 0, "ODA[%u] %u%c:%s, cnt:%u", idx, rds_data.oda[idx].gt.code,
-             rds_data.oda[idx].gt.version, oda_name,
-             rds_data.oda[idx].pkt_count);
+    const char* oda_name = find_app_name(rds_data.oda[idx].id);
+    DrawText(y++, 0, "ODA[%u] %u%c:", idx, rds_data.oda[idx].gt.code,
+             rds_data.oda[idx].gt.version);
+    if (oda_name)
+      g_screen.Append(y - 1, "%s", oda_name);
+    else
+      g_screen.Append(y - 1, "0x%X", rds_data.oda[idx].id);
+    g_screen.Append(y - 1, ", cnt:%u", rds_data.oda[idx].pkt_count);
   }
 
-  mvprintw(y++, 0, "Update: %d", g_update_num);
-
-  refresh();
+  DrawText(y++, 0, "Update: %d", g_update_num);
 }
 
 void DrawCurrentStats() {
-  erase();
-
   si470x_state_t state;
   if (!si470x_get_state(g_tuner, &state))
     return;
-  rds_data rds_data;
-  if (!si470x_get_rds_data(g_tuner, &rds_data))
-    return;
+  const rds_data& rds_data = g_rds_data;
 
   int top = DrawHeader(state, rds_data);
   int y = top;
-  mvprintw(y++, 0, "Group     A       B");
-  mvprintw(y++, 0, "-----  ------- -------");
+  int x = 0;
+  DrawText(y++, 0, "Group     A       B");
+  DrawText(y++, 0, "-----  ------- -------");
 #if defined(RDS_DEV)
   for (int i = 0; i < 16; i++) {
     char A[20];
@@ -310,49 +740,72 @@ void DrawCurrentStats() {
     int a_padding = 5 - strlen(A);
     int b_padding = 5 - strlen(B);
 
-    mvprintw(y++, 0, "  %02d    %*s%s   %*s%s", i, a_padding, " ", A, b_padding,
+    DrawText(y++, 0, "  %02d    %*s%s   %*s%s", i, a_padding, " ", A, b_padding,
              " ", B);
   }
 
   y = top;
-  const int x = 30;
-  mvprintw(y++, x, "     Group Data");
-  mvprintw(y++, x, "----------------------");
-  mvprintw(y++, x, "RDS count:      %d", rds_data.stats.data_cnt);
-  mvprintw(y++, x, "Block B errors: %d", rds_data.stats.blckb_errors);
-
-  mvprintw(y++, x, "AF:      %d", rds_data.stats.counts[PKTCNT_AF]);
-  mvprintw(y++, x, "CLOCK:   %d", rds_data.stats.counts[PKTCNT_CLOCK]);
-  mvprintw(y++, x, "EON:     %d", rds_data.stats.counts[PKTCNT_EON]);
-  mvprintw(y++, x, "EWS:     %d", rds_data.stats.counts[PKTCNT_EWS]);
-  mvprintw(y++, x, "FBT:     %d", rds_data.stats.counts[PKTCNT_FBT]);
-  mvprintw(y++, x, "IH:      %d", rds_data.stats.counts[PKTCNT_IH]);
-  mvprintw(y++, x, "MS:      %d", rds_data.stats.counts[PKTCNT_MS]);
-  mvprintw(y++, x, "PAGING:  %d", rds_data.stats.counts[PKTCNT_PAGING]);
-  mvprintw(y++, x, "PI_CODE: %d", rds_data.stats.counts[PKTCNT_PI_CODE]);
-  mvprintw(y++, x, "PS:      %d", rds_data.stats.counts[PKTCNT_PS]);
-  mvprintw(y++, x, "PTY:     %d", rds_data.stats.counts[PKTCNT_PTY]);
-  mvprintw(y++, x, "PTYN:    %d", rds_data.stats.counts[PKTCNT_PTYN]);
-  mvprintw(y++, x, "RT:      %d", rds_data.stats.counts[PKTCNT_RT]);
-  mvprintw(y++, x, "SLC:     %d", rds_data.stats.counts[PKTCNT_SLC]);
-  mvprintw(y++, x, "TA_CODE: %d", rds_data.stats.counts[PKTCNT_TA_CODE]);
-  mvprintw(y++, x, "TDC:     %d", rds_data.stats.counts[PKTCNT_TDC]);
-  mvprintw(y++, x, "TMC:     %d", rds_data.stats.counts[PKTCNT_TMC]);
-  mvprintw(y++, x, "TP_CODE: %d", rds_data.stats.counts[PKTCNT_TP_CODE]);
-
-  mvprintw(y++, x, "RT+:     %d", g_oda_data->stats.rtplus_cnt);
-  mvprintw(y++, x, "RDS-TMC: %d", g_oda_data->stats.tmc_cnt);
-  mvprintw(y++, x, "iTunes:  %d", g_oda_data->stats.itunes_cnt);
+  x = 30;
+  DrawText(y++, x, "     Group Data");
+  DrawText(y++, x, "----------------------");
+  DrawText(y++, x, "RDS count:      %d", rds_data.stats.data_cnt);
+  DrawText(y++, x, "Block B errors: %d", rds_data.stats.blckb_errors);
+
+  DrawText(y++, x, "AF:      %d", rds_data.stats.counts[PKTCNT_AF]);
+  DrawText(y++, x, "CLOCK:   %d", rds_data.stats.counts[PKTCNT_CLOCK]);
+  DrawText(y++, x, "EON:     %d", rds_data.stats.counts[PKTCNT_EON]);
+  DrawText(y++, x, "EWS:     %d", rds_data.stats.counts[PKTCNT_EWS]);
+  DrawText(y++, x, "FBT:     %d", rds_data.stats.counts[PKTCNT_FBT]);
+  DrawText(y++, x, "IH:      %d", rds_data.stats.counts[PKTCNT_IH]);
+  DrawText(y++, x, "MS:      %d", rds_data.stats.counts[PKTCNT_MS]);
+  DrawText(y++, x, "PAGING:  %d", rds_data.stats.counts[PKTCNT_PAGING]);
+  DrawText(y++, x, "PI_CODE: %d", rds_data.stats.counts[PKTCNT_PI_CODE]);
+  DrawText(y++, x, "PS:      %d", rds_data.stats.counts[PKTCNT_PS]);
+  DrawText(y++, x, "PTY:     %d", rds_data.stats.counts[PKTCNT_PTY]);
+  DrawText(y++, x, "PTYN:    %d", rds_data.stats.counts[PKTCNT_PTYN]);
+  DrawText(y++, x, "RT:      %d", rds_data.stats.counts[PKTCNT_RT]);
+  DrawText(y++, x, "SLC:     %d", rds_data.stats.counts[PKTCNT_SLC]);
+  DrawText(y++, x, "TA_CODE: %d", rds_data.stats.counts[PKTCNT_TA_CODE]);
+  DrawText(y++, x, "TDC:     %d", rds_data.stats.counts[PKTCNT_TDC]);
+  DrawText(y++, x, "TMC:     %d", rds_data.stats.counts[PKTCNT_TMC]);
+  DrawText(y++, x, "TP_CODE: %d", rds_data.stats.counts[PKTCNT_TP_CODE]);
+
+  DrawText(y++, x, "RT+:     %u",
+           get_oda_packet_count(&g_snapshot->oda, AID_RT_PLUS));
+  DrawText(y++, x, "RDS-TMC: %u (%d messages)",
+           get_oda_packet_count(&g_snapshot->oda, AID_TMC),
+           g_snapshot->oda.tmc.message_cnt);
+  DrawText(y++, x, "iTunes:  %u",
+           get_oda_packet_count(&g_snapshot->oda, AID_ITUNES));
 #endif
+
+  // Main loop and cache counters, which live builds have too.
+  DrawText(y++, x, "PI cache: %u hits, %u misses", g_pi_cache.hits,
+           g_pi_cache.misses);
+  DrawText(y++, x, "RT+ rebuilds: %d of %d draws", g_rtplus_rebuild_cnt,
+           g_update_num);
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - g_loop_start;
+  const double secs = elapsed.count() > 0 ? elapsed.count() : 1;
+  DrawText(y++, x, "Wakeups: %.1f/s", g_wakeup_cnt / secs);
+  if (g_test_data_cache) {
+    const TestDataCache::Stats cache = g_test_data_cache->GetStats();
+    DrawText(y++, x, "Test data: %zu of %zu files, %.1f MB", cache.files,
+             g_rds_test_data.size(), cache.bytes / 1e6);
+    DrawText(y++, x, "Test data: %u hits, %u loads", cache.hits, cache.loads);
+  }
+  DrawText(y++, x, "Terminal: %.0f bytes/s, %u rows repainted",
+           (GetThreadBytesWritten() - g_loop_start_bytes) / secs,
+           g_screen.repaint_cnt());
 }
 
 int DrawAFTable(int y, int x, int table_num, const struct rds_af_table* table) {
   if (table->tuned_freq.freq) {
     if (table->tuned_freq.band == AF_BAND_UHF) {
-      mvprintw(y++, x, "%d) Tuned freq: %.1f MHz", table_num,
+      DrawText(y++, x, "%d) Tuned freq: %.1f MHz", table_num,
                table->tuned_freq.freq / 10.0f);
     } else {
-      mvprintw(y++, x, "%d) Tuned freq: %u KHz", table_num,
+      DrawText(y++, x, "%d) Tuned freq: %u KHz", table_num,
                table->tuned_freq.freq);
     }
   }
@@ -364,29 +817,25 @@ int DrawAFTable(int y, int x, int table_num, const struct rds_af_table* table) {
     else
       strcpy(method, "Rgn. variant");
     if (table->entry[i].band == AF_BAND_UHF) {
-      mvprintw(y++, x, "%02d  %.1f MHz  %s", i, table->entry[i].freq / 10.0f,
+      DrawText(y++, x, "%02d  %.1f MHz  %s", i, table->entry[i].freq / 10.0f,
                method);
     } else {
-      mvprintw(y++, x, "%02d  %u KHz  %s", i, table->entry[i].freq, method);
+      DrawText(y++, x, "%02d  %u KHz  %s", i, table->entry[i].freq, method);
     }
   }
   return y;
 }
 
 void DrawAlternativeFrequencies() {
-  erase();
-
   si470x_state_t state;
   if (!si470x_get_state(g_tuner, &state))
     return;
-  rds_data rds_data;
-  if (!si470x_get_rds_data(g_tuner, &rds_data))
-    return;
+  const rds_data& rds_data = g_rds_data;
 
   int y = DrawHeader(state, rds_data);
 
   if (!rds_data.af.count) {
-    mvprintw(y, 0, "No alternative frequencies.");
+    DrawText(y, 0, "No alternative frequencies.");
     return;
   }
 
@@ -404,7 +853,7 @@ void DrawAlternativeFrequencies() {
       break;
   }
 
-  mvprintw(y++, 0, "Encoding method: %c", encoding_method);
+  DrawText(y++, 0, "Encoding method: %c", encoding_method);
 
   const int col_width = 30;
   const int max_cols = getmaxx(g_window) / col_width;
@@ -423,19 +872,15 @@ void DrawAlternativeFrequencies() {
 }
 
 void DrawEON() {
-  erase();
-
   si470x_state_t state;
   if (!si470x_get_state(g_tuner, &state))
     return;
-  rds_data rds_data;
-  if (!si470x_get_rds_data(g_tuner, &rds_data))
-    return;
+  const rds_data& rds_data = g_rds_data;
 
   int y = DrawHeader(state, rds_data);
 
   if (!(rds_data.valid_values & RDS_EON)) {
-    mvprintw(y, 0, "No EON data");
+    DrawText(y, 0, "No EON data");
     return;
   }
 
@@ -443,17 +888,17 @@ void DrawEON() {
   memcpy(ps, (char*)rds_data.eon.on.ps, sizeof(rds_data.eon.on.ps));
   MakeSpaces(ps, ARRAY_SIZE(ps) - 1);
   ps[ARRAY_SIZE(ps) - 1] = '\0';
-  mvprintw(y++, 0, "PS:  [%s]", ps);
-  mvprintw(y++, 0, "PTY: %s",
-           get_pty_code_name(rds_data.eon.on.pty, REGION_US));
-  mvprintw(y++, 0, "Traffic TP: %c, TA: %c",
+  DrawText(y++, 0, "PS:  [%s]", ps);
+  DrawText(y++, 0, "PTY: %s",
+           get_pty_code_name(rds_data.eon.on.pty, g_region));
+  DrawText(y++, 0, "Traffic TP: %c, TA: %c",
            rds_data.eon.on.tp_code ? 'Y' : 'N',
            rds_data.eon.on.ta_code ? 'Y' : 'N');
 
   if (rds_data.eon.on.af.table.count) {
     y++;
-    mvprintw(y++, 0, "Alternative Frequencies");
-    mvprintw(y++, 0, "=======================");
+    DrawText(y++, 0, "Alternative Frequencies");
+    DrawText(y++, 0, "=======================");
     char encoding_method;
     switch (rds_data.eon.on.af.enc_method) {
       case AF_EM_UNKNOWN:
@@ -467,7 +912,7 @@ void DrawEON() {
         break;
     }
 
-    mvprintw(y++, 0, "Encoding method: %c", encoding_method);
+    DrawText(y++, 0, "Encoding method: %c", encoding_method);
 
     y = DrawAFTable(y, 0, 1, &rds_data.eon.on.af.table);
   }
@@ -476,7 +921,7 @@ void DrawEON() {
 void DrawFooter() {
   const int y = getmaxy(g_window) - 1;
 
-  mvprintw(y, 0,
+  DrawText(y, 0,
            "Q/q: Quit, u: Seek up, "
            "d: Seek down, b: Basic, s: Stats, "
            "a: AF table, e: EON");
@@ -485,6 +930,10 @@ void DrawFooter() {
 void Draw() {
   g_update_num++;
   g_dirty = false;
+  if (!si470x_get_rds_data(g_tuner, &g_rds_data))
+    return;
+  g_snapshot = &g_decoder_state.Snapshot();
+  g_screen.Clear();
   switch (g_draw_mode) {
     case DrawMode::Basic:
       DrawCurrentState();
@@ -500,39 +949,194 @@ void Draw() {
       break;
   }
   DrawFooter();
+  g_screen.Flush();
+}
+
+// Index the test files (RDS Spy logs or captures) |fnames| into
+// g_rds_test_data, in the same order.
+// The files aren't read until selected - see TestDataCache.
+int IndexTestData(const std::vector<std::string>& fnames) {
+  for (const std::string& fname : fnames) {
+    struct stat sb;
+    if (-1 == stat(fname.c_str(), &sb)) {
+      perror(fname.c_str());
+      return 5;
+    }
+    g_rds_test_data.push_back({fname, sb.st_size});
+  }
+  return 0;
+}
+
+// The test file after |idx| in |step| (1 or -1) order, wrapping around.
+size_t NextTestFile(size_t idx, int step) {
+  if (step > 0)
+    return idx + 1 < g_rds_test_data.size() ? idx + 1 : 0;
+  return idx ? idx - 1 : g_rds_test_data.size() - 1;
+}
+
+#if defined(RDS_DEV)
+// Get |len| characters of display text, made printable.
+std::string GetDisplayText(const char* display, size_t len) {
+  char text[sizeof(rds_rt::display) + 1];
+  len = std::min(len, sizeof(text) - 1);
+  memcpy(text, display, len);
+  MakeSpaces(text, len);
+  text[len] = '\0';
+  TrimTrailingWhitespace(text);
+  return text;
+}
+
+void PrintReplayState(const rds_data& rds_data) {
+  printf("PI:   0x%04X\n", rds_data.pi_code);
+  if (rds_data.valid_values & RDS_PS) {
+    const std::string ps =
+        GetDisplayText(rds_data.ps.display, sizeof(rds_data.ps.display));
+    printf("PS:   [%s]\n", ps.c_str());
+  }
+  if (rds_data.valid_values & RDS_PTY)
+    printf("PTY:  %s\n", get_pty_code_name(rds_data.pty, g_region));
+  if (rds_data.valid_values & RDS_RT) {
+    const std::string rta =
+        GetDisplayText(rds_data.rt.a.display, sizeof(rds_data.rt.a.display));
+    const std::string rtb =
+        GetDisplayText(rds_data.rt.b.display, sizeof(rds_data.rt.b.display));
+    printf("RTA:  \"%s\"\n", rta.c_str());
+    printf("RTB:  \"%s\"\n", rtb.c_str());
+    UpdateRTPlusLines();
+    for (const std::string& line : g_rtplus_lines)
+      printf("%s\n", line.c_str());
+    uint32_t cursor = 0;
+    while (const struct rtplus_item* played =
+               get_next_rtplus_item(&g_snapshot->oda, &cursor)) {
+      printf("Played: \"%s\" by \"%s\" (%us)\n", played->title,
+             played->artist, played->ended - played->started);
+    }
+  }
+  if (rds_data.valid_values & RDS_CLOCK && ContainsTime(&rds_data))
+    printf("CT:   %s\n", format_local_time_cached(&g_time_cache, &rds_data));
+  for (uint16_t idx = 0; idx < g_snapshot->oda.tmc.message_cnt; idx++) {
+    printf("TMC:  %s\n",
+           FormatTMCMessage(g_snapshot->oda.tmc.messages[idx]).c_str());
+  }
+  for (uint8_t idx = 0; idx < rds_data.oda_cnt; idx++) {
+    const char* oda_name = find_app_name(rds_data.oda[idx].id);
+    printf("ODA[%u] %u%c:", idx, rds_data.oda[idx].gt.code,
+           rds_data.oda[idx].gt.version);
+    if (oda_name)
+      printf("%s", oda_name);
+    else
+      printf("0x%X", rds_data.oda[idx].id);
+    printf(", cnt:%u\n", rds_data.oda[idx].pkt_count);
+  }
+}
+
+// Decode each test file as fast as possible, and print the decoded state.
+int Replay() {
+  using Clock = std::chrono::steady_clock;
+  uint64_t total_groups = 0;
+  int ret = 0;
+  const auto start = Clock::now();
+  for (size_t idx = 0; idx < g_rds_test_data.size(); idx++) {
+    const RDSTestData& test_data = g_rds_test_data[idx];
+    std::string error;
+    const TestDataCache::Blocks blocks = g_test_data_cache->Get(idx, &error);
+    if (!blocks) {
+      fprintf(stderr, "%s\n\n", error.c_str());
+      if (!ret)
+        ret = TestDataCache::kUnreadable;
+      continue;
+    }
+    const auto file_start = Clock::now();
+    if (!si470x_power_on_test(g_tuner, blocks->data(), blocks->size(),
+                              /*delay_ms=*/0)) {
+      fprintf(stderr, "Unable to power on tuner with test data.\n");
+      return 1;
+    }
+    rds_data rds_data;
+    uint32_t last_cnt = 0;
+    auto last_progress = file_start;
+    for (;;) {
+      if (!si470x_get_rds_data(g_tuner, &rds_data))
+        return 1;
+      const auto now = Clock::now();
+      if (rds_data.stats.data_cnt >= blocks->size())
+        break;
+      if (rds_data.stats.data_cnt != last_cnt) {
+        last_cnt = rds_data.stats.data_cnt;
+        last_progress = now;
+      } else if (now - last_progress >= kReplayStallTimeout) {
+        break;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const std::chrono::duration<double> elapsed = Clock::now() - file_start;
+    if (!si470x_power_off(g_tuner))
+      return 1;
+
+    // The callbacks have stopped, so this is the final ODA state.
+    g_snapshot = &g_decoder_state.Snapshot();
+    printf("File: \"%s\"\n", test_data.fname.c_str());
+    PrintReplayState(rds_data);
+    printf("Groups: %u of %zu in %.3f s (%.0f groups/s)\n\n",
+           rds_data.stats.data_cnt, blocks->size(), elapsed.count(),
+           rds_data.stats.data_cnt / elapsed.count());
+    total_groups += rds_data.stats.data_cnt;
+
+    g_decoder_state.Update(clear_oda_data, nullptr);
+  }
+  const std::chrono::duration<double> elapsed = Clock::now() - start;
+  printf("Total: %llu groups in %.3f s (%.0f groups/s)\n",
+         static_cast<unsigned long long>(total_groups), elapsed.count(),
+         total_groups / elapsed.count());
+  return ret;
 }
+#endif  // defined(RDS_DEV)
 
 }  // namespace
 
 int main(int argc, const char** argv) {
   int ret;
 
-  if (argc == 2) {
+  const char* test_path = nullptr;
+  size_t cache_mb = kDefaultCacheMB;
+  bool bad_args = false;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--replay")) {
+      g_replay = true;
+    } else if (!strncmp(argv[i], "--cache-mb=", 11)) {
+      cache_mb = strtoul(argv[i] + 11, nullptr, 10);
+    } else if (!test_path && argv[i][0] != '-') {
+      test_path = argv[i];
+    } else {
+      bad_args = true;
+    }
+  }
+  // Replaying needs test data, so RDS_DEV too: without them the tuner would
+  // run live.
+  bool can_replay = test_path != nullptr;
+#if !defined(RDS_DEV)
+  can_replay = false;
+#endif
+  if (bad_args || (g_replay && !can_replay)) {
+    fprintf(stderr,
+            "usage: %s [--replay] [--cache-mb=<MB>] "
+            "[<RDS Spy log/capture file or dir>]\n",
+            argv[0]);
+    return 1;
+  }
+  if (test_path) {
 #if !defined(RDS_DEV)
-    fprintf(stdout, "Can't run with test blocks without RDS_DEV defined\n");
+    fprintf(stderr, "Can't run with test blocks without RDS_DEV defined\n");
     return 1;
 #endif
-    auto readl = [](const std::string& fname) {
-      RDSTestData test_data;
-      test_data.fname = fname;
-      if (!LoadRdsSpyFile(fname.c_str(), &test_data.blocks)) {
-        fprintf(stderr, "Can't read \"%s\"\n", fname.c_str());
-        return 2;
-      }
-      if (test_data.blocks.empty()) {
-        fprintf(stderr, "\"%s\" is empty\n", fname.c_str());
-        return 3;
-      }
-      g_rds_test_data.push_back(test_data);
-      return 0;
-    };
+    std::vector<std::string> fnames;
     struct stat sb;
-    if (-1 == stat(argv[1], &sb)) {
+    if (-1 == stat(test_path, &sb)) {
       perror("Can't stat file/dir");
       return 5;
     }
     if (S_ISDIR(sb.st_mode)) {
-      DIR* dir = opendir(argv[1]);
+      DIR* dir = opendir(test_path);
       if (!dir) {
         perror("Cant open dir");
         return 6;
@@ -541,30 +1145,46 @@ int main(int argc, const char** argv) {
       while ((ent = readdir(dir)) != NULL) {
         if (!strcmp(".", ent->d_name) || !strcmp("..", ent->d_name))
           continue;
-        std::string fname = argv[1];
+        std::string fname = test_path;
         fname += '/';
         fname += ent->d_name;
-        if ((ret = readl(fname)))
-          return ret;
+        fnames.push_back(fname);
       }
       closedir(dir);
+      // readdir() order is arbitrary.
+      std::sort(fnames.begin(), fnames.end());
     } else {
-      if ((ret = readl(argv[1])))
-        return ret;
+      fnames.push_back(test_path);
     }
+    if ((ret = IndexTestData(fnames)))
+      return ret;
+    g_test_data_cache.reset(
+        new TestDataCache(&g_rds_test_data, cache_mb * 1024 * 1024));
   }
 
-  g_oda_data = create_oda_data();
+  // Created before the tuner so that they outlive its RDS callbacks.
+  g_rds_event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  FdCloser rds_event_closer(g_rds_event_fd);
+  const int update_timer_fd =
+      timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  FdCloser update_timer_closer(update_timer_fd);
+  const int tune_timer_fd =
+      timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  FdCloser tune_timer_closer(tune_timer_fd);
+  if (g_rds_event_fd == -1 || update_timer_fd == -1 || tune_timer_fd == -1) {
+    perror("Unable to create event/timer");
+    return 1;
+  }
 
   struct si470x_port_t* port = port_create(!g_rds_test_data.empty());
 
-  if (argc == 1 && !port_supports_gpio(port)) {
+  if (!test_path && !port_supports_gpio(port)) {
     fprintf(stderr,
             "This port doesn't support GPIO, "
             "can only run with test data\n");
     return 1;
   }
-  if (argc == 1 && !port_supports_i2c(port)) {
+  if (!test_path && !port_supports_i2c(port)) {
     fprintf(stderr,
             "This port doesn't support I2C, "
             "can only run with test data\n");
@@ -586,6 +1206,7 @@ int main(int argc, const char** argv) {
               .slave_addr = 0x10,
           },
   };
+  g_region = config.region;
   g_tuner = si470x_create(&config);
   TunerDeleter tuner_deleter;
 
@@ -595,31 +1216,54 @@ int main(int argc, const char** argv) {
   }
 
   si470x_set_rds_callback(g_tuner, &OnRDSChanged, NULL);
-  si470x_set_oda_callbacks(g_tuner, &DecodeODA, &ClearODA, g_oda_data);
+  si470x_set_oda_callbacks(g_tuner, &DecodeODA, &ClearODA, nullptr);
+
+#if defined(RDS_DEV)
+  if (g_replay)
+    return Replay();
+#endif
 
-  auto power_on_tuner = [=]() {
+  // Power on the tuner, with test file g_current_block_idx if there is test
+  // data. A file which can't be loaded is skipped for the next one in |step|
+  // order, so this only fails (with the first file's error) if none can be.
+  auto power_on_tuner = [=](int step, std::string* error) {
     if (g_rds_test_data.empty()) {
       if (!si470x_power_on(g_tuner)) {
-        fprintf(stderr, "Unable to power on tuner.\n");
+        *error = "Unable to power on tuner.";
         return 1;
       }
     } else {
 #if defined(RDS_DEV)
       const uint16_t rds_block_delay_ms = 50;
-      const auto& test_data = g_rds_test_data[g_current_block_idx];
-      if (!si470x_power_on_test(g_tuner, test_data.blocks.data(),
-                                test_data.blocks.size(), rds_block_delay_ms)) {
-        fprintf(stderr, "Unable to power on tuner with test data.\n");
+      std::string skipped_error;
+      g_current_blocks.reset();
+      for (size_t i = 0; !g_current_blocks && i < g_rds_test_data.size();
+           i++) {
+        if (i)
+          g_current_block_idx = NextTestFile(g_current_block_idx, step);
+        g_current_blocks = g_test_data_cache->Get(
+            g_current_block_idx, i ? &skipped_error : error);
+      }
+      if (!g_current_blocks)
+        return 2;
+      if (!si470x_power_on_test(g_tuner, g_current_blocks->data(),
+                                g_current_blocks->size(), rds_block_delay_ms)) {
+        *error = "Unable to power on tuner with test data.";
         return 1;
       }
+#else
+      (void)step;
 #endif  // defined(RDS_DEV)
     }
     g_update_num = 0;
     return 0;
   };
 
-  if ((ret = power_on_tuner()))
+  std::string error;
+  if ((ret = power_on_tuner(1, &error))) {
+    fprintf(stderr, "%s\n", error.c_str());
     return ret;
+  }
 
   const int frequency = 98500000;
   if (!si470x_set_frequency(g_tuner, frequency)) {
@@ -646,35 +1290,38 @@ int main(int argc, const char** argv) {
   nodelay(stdscr, TRUE);
   bool done = false;
 
-  auto now = std::chrono::system_clock::now().time_since_epoch();
-  auto next_update_time = now + kUpdateInterval;
-  auto next_tune_time = now + kTuneInterval;
   bool auto_tune = g_rds_test_data.empty();
+  ArmTimer(update_timer_fd, kUpdateInterval, /*repeat=*/false);
+  if (auto_tune)
+    ArmTimer(tune_timer_fd, kTuneInterval, /*repeat=*/true);
+
+  // Sleep until a key is pressed, the RDS data changes, or a timer expires.
+  struct pollfd fds[] = {
+      {STDIN_FILENO, POLLIN, 0},
+      {g_rds_event_fd, POLLIN, 0},
+      {update_timer_fd, POLLIN, 0},
+      {tune_timer_fd, POLLIN, 0},
+  };
+  g_loop_start = std::chrono::steady_clock::now();
+  g_loop_start_bytes = GetThreadBytesWritten();
 
   while (!done) {
-    now = std::chrono::system_clock::now().time_since_epoch();
-    if ((ch = getch()) == ERR) {
-      // No key.
-      bool do_sleep = true;
-      if (g_dirty) {
-        Draw();
-        next_update_time = now + kUpdateInterval;
-        do_sleep = false;
-      } else if (now >= next_update_time) {
-        // Gone too long w/o RDS trigger, poll and update.
-        Draw();
-        next_update_time = now + kUpdateInterval;
-        do_sleep = false;
-      }
-      if (auto_tune && now >= next_tune_time) {
-        bool reached_sfbl;
-        si470x_seek_up(g_tuner, /*allow_wrap=*/true, &reached_sfbl);
-        next_tune_time = now + kTuneInterval;
-        do_sleep = false;
-      }
-      if (do_sleep)
-        std::this_thread::sleep_for(kSleepDuration);
-    } else {
+    if (poll(fds, ARRAY_SIZE(fds), -1) == -1) {
+      if (errno == EINTR)
+        continue;
+      perror("poll");
+      return 1;
+    }
+    g_wakeup_cnt++;
+    ConsumeFd(g_rds_event_fd);
+    // Gone too long w/o RDS trigger, poll and update.
+    if (ConsumeFd(update_timer_fd))
+      g_dirty = true;
+    if (ConsumeFd(tune_timer_fd) && auto_tune) {
+      bool reached_sfbl;
+      si470x_seek_up(g_tuner, /*allow_wrap=*/true, &reached_sfbl);
+    }
+    while (!done && (ch = getch()) != ERR) {
       bool reached_sfbl;
       switch (ch) {
         case 'a':
@@ -698,39 +1345,53 @@ int main(int argc, const char** argv) {
           break;
         case 'u':
           auto_tune = false;
+          ArmTimer(tune_timer_fd, std::chrono::seconds(0), /*repeat=*/false);
           if (g_rds_test_data.empty()) {
             si470x_seek_up(g_tuner, /*allow_wrap=*/true, &reached_sfbl);
           } else {
-            if (g_current_block_idx++ >= g_rds_test_data.size() - 1)
-              g_current_block_idx = 0;
+            g_current_block_idx = NextTestFile(g_current_block_idx, 1);
             if (!si470x_power_off(g_tuner)) {
               return 1;
             }
-            if ((ret = power_on_tuner()))
+            if ((ret = power_on_tuner(1, &error))) {
+              endwin();
+              fprintf(stderr, "%s\n", error.c_str());
               return ret;
+            }
           }
           g_dirty = true;
           break;
         case 'd':
           auto_tune = false;
+          ArmTimer(tune_timer_fd, std::chrono::seconds(0), /*repeat=*/false);
           if (g_rds_test_data.empty()) {
             si470x_seek_down(g_tuner, /*allow_wrap=*/true, &reached_sfbl);
           } else {
-            if (g_current_block_idx-- == 0)
-              g_current_block_idx = g_rds_test_data.size() - 1;
+            g_current_block_idx = NextTestFile(g_current_block_idx, -1);
             if (!si470x_power_off(g_tuner))
               return 1;
-            if ((ret = power_on_tuner()))
+            if ((ret = power_on_tuner(-1, &error))) {
+              endwin();
+              fprintf(stderr, "%s\n", error.c_str());
               return ret;
+            }
           }
           g_dirty = true;
           break;
+        case KEY_RESIZE:
+          g_screen.Invalidate();
+          g_dirty = true;
+          break;
         case 'q':
         case 'Q':
           done = true;
           break;
       }
     }
+    if (g_dirty) {
+      Draw();
+      ArmTimer(update_timer_fd, kUpdateInterval, /*repeat=*/false);
+    }
   }
 
   return 0;
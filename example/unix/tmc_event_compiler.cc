@@ -0,0 +1,274 @@
+// Compile the ISO 14819-2 event list into the event table included by
+// util/tmc_events.c.
+//
+// Input is one event per line, with a header line, separated by ';':
+//
+//   CODE;TEXT;N;Q;T;D;U;C;DP
+//
+// CODE  Event code (1..2047).
+// TEXT  English text.
+// N     Nature: empty (information), F (forecast) or S (silent).
+// Q     Quantifier type (0..12, see enum tmc_quantifier_type), or empty.
+// T     Duration type: D (dynamic) or L (longer lasting).
+// D     Directionality: 1 (unidirectional) or 2 (bidirectional).
+// U     Urgency: empty (normal), U (urgent) or X (extremely urgent).
+// C     Update class (1..39).
+// DP    Default duration (0..7): the duration and persistence value used
+//       when a message gives none.
+//
+// The table in the tree is regenerated with:
+//
+//   tmc_event_compiler util/tmc_event_list.csv util/tmc_event_table.h
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <tmc_events.h>
+
+namespace {
+
+struct Event {
+  uint16_t code;
+  uint16_t text;  // Index into the text table.
+  const char* nature;
+  const char* quantifier;
+  bool longer_lasting;
+  bool bidirectional;
+  const char* urgency;
+  uint8_t update_class;
+  uint8_t default_duration;
+};
+
+const char* const kQuantifierNames[] = {
+    "TMC_Q_SMALL_NUMBER",  "TMC_Q_NUMBER",       "TMC_Q_LESS_THAN_METRES",
+    "TMC_Q_PERCENT",       "TMC_Q_SPEED",        "TMC_Q_DURATION",
+    "TMC_Q_TEMPERATURE",   "TMC_Q_TIME",         "TMC_Q_WEIGHT",
+    "TMC_Q_LENGTH",        "TMC_Q_PRECIPITATION", "TMC_Q_FM_FREQUENCY",
+    "TMC_Q_AM_FREQUENCY",
+};
+
+std::string Trim(const std::string& str) {
+  size_t begin = 0;
+  size_t end = str.size();
+  while (begin < end && isspace(static_cast<unsigned char>(str[begin])))
+    begin++;
+  while (end > begin && isspace(static_cast<unsigned char>(str[end - 1])))
+    end--;
+  return str.substr(begin, end - begin);
+}
+
+std::vector<std::string> SplitLine(const std::string& line) {
+  std::vector<std::string> fields;
+  size_t start = 0;
+  for (;;) {
+    const size_t pos = line.find(';', start);
+    if (pos == std::string::npos) {
+      fields.push_back(Trim(line.substr(start)));
+      return fields;
+    }
+    fields.push_back(Trim(line.substr(start, pos - start)));
+    start = pos + 1;
+  }
+}
+
+// Parse |str| as a number in [min, max]. Returns false if it isn't one.
+bool ParseNumber(const std::string& str, long min, long max, long* val) {
+  if (str.empty())
+    return false;
+  char* end;
+  *val = strtol(str.c_str(), &end, 10);
+  return !*end && *val >= min && *val <= max;
+}
+
+// Texts are stored once, no matter how many events use them.
+class TextTable {
+ public:
+  TextTable() : texts_(1) {}
+
+  uint16_t Add(const std::string& text) {
+    auto it = indexes_.find(text);
+    if (it != indexes_.end())
+      return it->second;
+    const uint16_t index = texts_.size();
+    texts_.push_back(text);
+    indexes_[text] = index;
+    return index;
+  }
+
+  const std::vector<std::string>& texts() const { return texts_; }
+
+ private:
+  std::vector<std::string> texts_;
+  std::map<std::string, uint16_t> indexes_;
+};
+
+bool ParseEvent(const std::vector<std::string>& fields,
+                TextTable* texts,
+                Event* event) {
+  long code, quantifier = TMC_Q_NONE, update_class, duration;
+  if (fields.size() != 9 || !ParseNumber(fields[0], 1, TMC_NUM_EVENTS - 1,
+                                         &code) ||
+      fields[1].empty() ||
+      !(fields[3].empty() || ParseNumber(fields[3], 0, 12, &quantifier)) ||
+      !ParseNumber(fields[7], 1, 39, &update_class) ||
+      !ParseNumber(fields[8], 0, 7, &duration)) {
+    return false;
+  }
+  event->code = code;
+  event->text = texts->Add(fields[1]);
+  event->quantifier =
+      quantifier == TMC_Q_NONE ? "TMC_Q_NONE" : kQuantifierNames[quantifier];
+  event->update_class = update_class;
+  event->default_duration = duration;
+
+  if (fields[2].empty())
+    event->nature = "TMC_NATURE_INFO";
+  else if (fields[2] == "F")
+    event->nature = "TMC_NATURE_FORECAST";
+  else if (fields[2] == "S")
+    event->nature = "TMC_NATURE_SILENT";
+  else
+    return false;
+
+  if (fields[4] != "D" && fields[4] != "L")
+    return false;
+  event->longer_lasting = fields[4] == "L";
+
+  if (fields[5] != "1" && fields[5] != "2")
+    return false;
+  event->bidirectional = fields[5] == "2";
+
+  if (fields[6].empty())
+    event->urgency = "TMC_URGENCY_NORMAL";
+  else if (fields[6] == "U")
+    event->urgency = "TMC_URGENCY_URGENT";
+  else if (fields[6] == "X")
+    event->urgency = "TMC_URGENCY_EXTREMELY_URGENT";
+  else
+    return false;
+  return true;
+}
+
+bool ReadEvents(const char* fname,
+                std::vector<Event>* events,
+                TextTable* texts) {
+  FILE* f = fopen(fname, "r");
+  if (!f) {
+    perror(fname);
+    return false;
+  }
+  std::vector<bool> seen(TMC_NUM_EVENTS);
+  char buff[1024];
+  bool ok = true;
+  for (int line = 1; ok && fgets(buff, sizeof(buff), f); line++) {
+    const std::string str = Trim(buff);
+    if (line == 1 || str.empty())
+      continue;  // Header.
+    Event event;
+    if (!ParseEvent(SplitLine(str), texts, &event)) {
+      fprintf(stderr, "%s:%d: invalid event\n", fname, line);
+      ok = false;
+    } else if (seen[event.code]) {
+      fprintf(stderr, "%s:%d: event %u given twice\n", fname, line,
+              event.code);
+      ok = false;
+    } else {
+      seen[event.code] = true;
+      events->push_back(event);
+    }
+  }
+  fclose(f);
+  if (ok && events->empty()) {
+    fprintf(stderr, "\"%s\" has no events\n", fname);
+    return false;
+  }
+  return ok;
+}
+
+std::string Escape(const std::string& text) {
+  std::string escaped;
+  for (char ch : text) {
+    if (ch == '"' || ch == '\\')
+      escaped += '\\';
+    escaped += ch;
+  }
+  return escaped;
+}
+
+bool WriteTable(const char* fname,
+                const std::vector<Event>& events,
+                const TextTable& texts) {
+  // The text index is 11 bits, and offsets are 16 bits.
+  size_t text_size = 0;
+  for (const std::string& text : texts.texts())
+    text_size += text.size() + 1;
+  if (texts.texts().size() > 2048 || text_size > 0x10000) {
+    fprintf(stderr, "Too much event text\n");
+    return false;
+  }
+
+  FILE* f = fopen(fname, "w");
+  if (!f) {
+    perror(fname);
+    return false;
+  }
+  fprintf(f,
+          "// Generated by tmc_event_compiler from tmc_event_list.csv. Do not "
+          "edit.\n"
+          "//\n"
+          "// Only included by tmc_events.c.\n\n"
+          "// clang-format off\n\n"
+          "/** The event texts. Index 0 is the empty string. */\n"
+          "static const char kTMCEventTextData[] =\n");
+  for (const std::string& text : texts.texts())
+    fprintf(f, "    \"%s\\0\"\n", Escape(text).c_str());
+  fprintf(f,
+          "    ;\n\n"
+          "/** The offset in kTMCEventTextData of each text index. */\n"
+          "static const uint16_t kTMCEventTextOffset[%zu] = {\n",
+          texts.texts().size());
+  size_t offset = 0;
+  for (const std::string& text : texts.texts()) {
+    fprintf(f, "    %zu,\n", offset);
+    offset += text.size() + 1;
+  }
+  fprintf(f,
+          "};\n\n"
+          "/** The event list, indexed by event code. Unlisted events are "
+          "zero. */\n"
+          "static const uint32_t kTMCEvents[TMC_NUM_EVENTS] = {\n");
+  for (const Event& e : events) {
+    fprintf(f, "    [%u] = EVENT(%u, %s, %s, %s, %d, %d, %u, %u),\n", e.code,
+            e.text, e.nature, e.urgency, e.quantifier, e.longer_lasting,
+            e.bidirectional, e.update_class, e.default_duration);
+  }
+  fprintf(f, "};\n\n// clang-format on\n");
+  if (fclose(f) != 0) {
+    fprintf(stderr, "Unable to write \"%s\"\n", fname);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, const char** argv) {
+  if (argc != 3) {
+    fprintf(stderr, "usage: %s <event list> <table header>\n", argv[0]);
+    return 1;
+  }
+  std::vector<Event> events;
+  TextTable texts;
+  if (!ReadEvents(argv[1], &events, &texts))
+    return 2;
+  if (!WriteTable(argv[2], events, texts))
+    return 3;
+  printf("%zu events, %zu texts\n", events.size(), texts.texts().size() - 1);
+  return 0;
+}
@@ -0,0 +1,287 @@
+// Compile ISO 14819-3 TMC location tables into an index for
+// open_tmc_location_index().
+//
+// Input is the usual location code list (LCL) text export: one location per
+// line with a header line naming the columns, separated by ';' (or ',').
+// Columns are matched by name, ignoring case, spaces and underscores, so both
+// the "LOCATION CODE;TYPE;ROAD NUMBER;..." and the LTEF style
+// "LCD;CLASS;TCD;STCD;..." headers are understood. Names must be inline
+// (LTEF name IDs are not resolved).
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <tmc_locations.h>
+
+namespace {
+
+struct Table {
+  uint8_t ltn;
+  std::vector<struct tmc_index_record> records;
+};
+
+// Strings are stored once, no matter how many locations use them.
+class StringTable {
+ public:
+  StringTable() : data_(1, '\0') {}
+
+  uint32_t Add(const std::string& str) {
+    if (str.empty())
+      return 0;
+    auto it = offsets_.find(str);
+    if (it != offsets_.end())
+      return it->second;
+    const uint32_t offset = data_.size();
+    data_.insert(data_.end(), str.begin(), str.end());
+    data_.push_back('\0');
+    offsets_[str] = offset;
+    return offset;
+  }
+
+  const std::vector<char>& data() const { return data_; }
+
+ private:
+  std::vector<char> data_;
+  std::map<std::string, uint32_t> offsets_;
+};
+
+std::string NormalizeColumnName(const std::string& name) {
+  std::string norm;
+  for (char ch : name) {
+    if (isalnum(static_cast<unsigned char>(ch)))
+      norm += toupper(static_cast<unsigned char>(ch));
+  }
+  return norm;
+}
+
+std::string Trim(const std::string& str) {
+  size_t begin = 0;
+  size_t end = str.size();
+  while (begin < end && (isspace(static_cast<unsigned char>(str[begin])) ||
+                         str[begin] == '"'))
+    begin++;
+  while (end > begin && (isspace(static_cast<unsigned char>(str[end - 1])) ||
+                         str[end - 1] == '"' || str[end - 1] == '\r'))
+    end--;
+  return str.substr(begin, end - begin);
+}
+
+std::vector<std::string> SplitLine(const std::string& line, char sep) {
+  std::vector<std::string> fields;
+  size_t start = 0;
+  for (;;) {
+    const size_t pos = line.find(sep, start);
+    if (pos == std::string::npos) {
+      fields.push_back(Trim(line.substr(start)));
+      return fields;
+    }
+    fields.push_back(Trim(line.substr(start, pos - start)));
+    start = pos + 1;
+  }
+}
+
+// The index of the first column named one of |names|, or -1.
+int FindColumn(const std::vector<std::string>& header,
+               std::initializer_list<const char*> names) {
+  for (const char* name : names) {
+    auto it = std::find(header.begin(), header.end(), name);
+    if (it != header.end())
+      return it - header.begin();
+  }
+  return -1;
+}
+
+std::string GetField(const std::vector<std::string>& fields, int col) {
+  return col >= 0 && col < static_cast<int>(fields.size()) ? fields[col] : "";
+}
+
+uint16_t GetCode(const std::vector<std::string>& fields, int col) {
+  return strtoul(GetField(fields, col).c_str(), nullptr, 10);
+}
+
+// Parse a type such as "P1.3" into class, type and subtype. Plain numbers
+// ("1") are also accepted.
+void ParseType(const std::string& str, struct tmc_index_record* rec) {
+  const char* p = str.c_str();
+  if (isalpha(static_cast<unsigned char>(*p)))
+    rec->loc_class = toupper(static_cast<unsigned char>(*p++));
+  char* end;
+  rec->type = strtoul(p, &end, 10);
+  if (*end == '.')
+    rec->subtype = strtoul(end + 1, nullptr, 10);
+}
+
+bool ReadTable(const char* fname, Table* table, StringTable* strings) {
+  FILE* f = fopen(fname, "r");
+  if (!f) {
+    perror(fname);
+    return false;
+  }
+  std::vector<std::string> lines;
+  char buff[4096];
+  while (fgets(buff, sizeof(buff), f))
+    lines.push_back(buff);
+  fclose(f);
+  if (lines.empty()) {
+    fprintf(stderr, "\"%s\" is empty\n", fname);
+    return false;
+  }
+
+  const char sep = lines[0].find(';') != std::string::npos ? ';' : ',';
+  std::vector<std::string> header = SplitLine(lines[0], sep);
+  for (auto& col : header)
+    col = NormalizeColumnName(col);
+
+  const int lcd_col = FindColumn(header, {"LOCATIONCODE", "LCD"});
+  const int class_col = FindColumn(header, {"CLASS"});
+  const int type_col = FindColumn(header, {"TYPE", "TCD"});
+  const int subtype_col = FindColumn(header, {"SUBTYPE", "STCD"});
+  const int road_number_col = FindColumn(header, {"ROADNUMBER", "ROADNR"});
+  const int road_name_col = FindColumn(header, {"ROADNAME"});
+  const int first_name_col = FindColumn(header, {"FIRSTNAME"});
+  const int second_name_col = FindColumn(header, {"SECONDNAME"});
+  const int area_col =
+      FindColumn(header, {"AREAREFERENCE", "AREAREF", "POLLCD"});
+  const int linear_col =
+      FindColumn(header, {"LINEARREFERENCE", "LINEARREF", "SEGLCD", "ROALCD"});
+  const int neg_col =
+      FindColumn(header, {"NEGATIVEOFFSET", "NEGOFFSET", "NEGOFFLCD"});
+  const int pos_col =
+      FindColumn(header, {"POSITIVEOFFSET", "POSOFFSET", "POSOFFLCD"});
+  if (lcd_col < 0) {
+    fprintf(stderr, "\"%s\" has no location code column\n", fname);
+    return false;
+  }
+
+  for (size_t i = 1; i < lines.size(); i++) {
+    const std::vector<std::string> fields = SplitLine(lines[i], sep);
+    const std::string lcd = GetField(fields, lcd_col);
+    if (lcd.empty())
+      continue;
+    struct tmc_index_record rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.lcd = strtoul(lcd.c_str(), nullptr, 10);
+    ParseType(GetField(fields, type_col), &rec);
+    if (class_col >= 0 && !GetField(fields, class_col).empty())
+      rec.loc_class = toupper(GetField(fields, class_col)[0]);
+    if (subtype_col >= 0)
+      rec.subtype = GetCode(fields, subtype_col);
+    rec.area_ref = GetCode(fields, area_col);
+    rec.linear_ref = GetCode(fields, linear_col);
+    rec.neg_offset = GetCode(fields, neg_col);
+    rec.pos_offset = GetCode(fields, pos_col);
+    rec.road_number = strings->Add(GetField(fields, road_number_col));
+    rec.road_name = strings->Add(GetField(fields, road_name_col));
+    rec.first_name = strings->Add(GetField(fields, first_name_col));
+    rec.second_name = strings->Add(GetField(fields, second_name_col));
+    table->records.push_back(rec);
+  }
+  if (table->records.empty()) {
+    fprintf(stderr, "\"%s\" has no locations\n", fname);
+    return false;
+  }
+  std::sort(table->records.begin(), table->records.end(),
+            [](const struct tmc_index_record& a,
+               const struct tmc_index_record& b) { return a.lcd < b.lcd; });
+  return true;
+}
+
+bool WriteIndex(const char* fname,
+                const std::vector<Table>& tables,
+                const StringTable& strings) {
+  std::vector<uint8_t> out(sizeof(struct tmc_index_header) +
+                           tables.size() * sizeof(struct tmc_index_table));
+  std::vector<struct tmc_index_table> dir;
+  for (const Table& table : tables) {
+    struct tmc_index_table entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.ltn = table.ltn;
+    entry.min_lcd = table.records.front().lcd;
+    entry.max_lcd = table.records.back().lcd;
+    entry.num_records = table.records.size();
+
+    std::vector<uint32_t> slots(entry.max_lcd - entry.min_lcd + 1, 0);
+    for (size_t i = 0; i < table.records.size(); i++)
+      slots[table.records[i].lcd - entry.min_lcd] = i + 1;
+
+    entry.slots_offset = out.size();
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(slots.data());
+    out.insert(out.end(), p, p + slots.size() * sizeof(uint32_t));
+
+    entry.records_offset = out.size();
+    p = reinterpret_cast<const uint8_t*>(table.records.data());
+    out.insert(out.end(), p,
+               p + table.records.size() * sizeof(struct tmc_index_record));
+    dir.push_back(entry);
+  }
+
+  struct tmc_index_header header;
+  memset(&header, 0, sizeof(header));
+  header.magic = TMC_INDEX_MAGIC;
+  header.version = TMC_INDEX_VERSION;
+  header.num_tables = tables.size();
+  header.strings_offset = out.size();
+  header.strings_size = strings.data().size();
+  out.insert(out.end(), strings.data().begin(), strings.data().end());
+  header.file_size = out.size();
+
+  memcpy(out.data(), &header, sizeof(header));
+  memcpy(out.data() + sizeof(header), dir.data(),
+         dir.size() * sizeof(struct tmc_index_table));
+
+  FILE* f = fopen(fname, "wb");
+  if (!f) {
+    perror(fname);
+    return false;
+  }
+  const bool ok = fwrite(out.data(), 1, out.size(), f) == out.size();
+  if (fclose(f) != 0 || !ok) {
+    fprintf(stderr, "Unable to write \"%s\"\n", fname);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, const char** argv) {
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s <index file> <ltn>=<lcl file> ...\n", argv[0]);
+    return 1;
+  }
+
+  StringTable strings;
+  std::vector<Table> tables;
+  for (int i = 2; i < argc; i++) {
+    const char* eq = strchr(argv[i], '=');
+    const int ltn = eq ? atoi(argv[i]) : 0;
+    if (!eq || ltn <= 0 || ltn >= TMC_NUM_LTN) {
+      fprintf(stderr, "Invalid table \"%s\", expected <ltn>=<lcl file>\n",
+              argv[i]);
+      return 1;
+    }
+    for (const Table& table : tables) {
+      if (table.ltn == ltn) {
+        fprintf(stderr, "Location table %d given twice\n", ltn);
+        return 1;
+      }
+    }
+    Table table;
+    table.ltn = ltn;
+    if (!ReadTable(eq + 1, &table, &strings))
+      return 2;
+    printf("LTN %d: %zu locations\n", ltn, table.records.size());
+    tables.push_back(std::move(table));
+  }
+
+  if (!WriteIndex(argv[1], tables, strings))
+    return 3;
+  return 0;
+}
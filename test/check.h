@@ -0,0 +1,47 @@
+// Minimal check and timing helpers shared by the tests and benchmarks.
+//
+// Checks report a failure and carry on, so that one run shows every
+// failure. Each test returns TestResult() from main().
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <chrono>
+
+inline int& FailureCount() {
+  static int failures;
+  return failures;
+}
+
+#define CHECK(cond)                                                    \
+  do {                                                                 \
+    if (!(cond)) {                                                     \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, \
+              #cond);                                                  \
+      FailureCount()++;                                                \
+    }                                                                  \
+  } while (0)
+
+inline int TestResult() {
+  if (FailureCount())
+    fprintf(stderr, "%d check(s) failed\n", FailureCount());
+  return FailureCount() ? 1 : 0;
+}
+
+// Call |fn| |count| times and print the rate. |fn| is passed the iteration
+// number and returns a value which is summed, so the work can't be optimised
+// away. Returns the rate (calls per second).
+template <typename Fn>
+double Benchmark(const char* name, uint32_t count, Fn fn) {
+  const auto start = std::chrono::steady_clock::now();
+  uint32_t sum = 0;
+  for (uint32_t i = 0; i < count; i++)
+    sum += fn(i);
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  const double rate = count / elapsed.count();
+  printf("%-32s %8.1f M/s  (%08X)\n", name, rate / 1e6, sum);
+  return rate;
+}
@@ -0,0 +1,158 @@
+// rdsdisplay's DecoderState: a tuner thread decodes RT+ groups into it while
+// the UI thread takes snapshots. Every snapshot must pair the ODA state with
+// the RDS data it was decoded with, and the tuner must never wait for the UI,
+// even while the UI holds on to a snapshot. Built with ThreadSanitizer.
+//
+// The tuner holds its own lock while updating the RDS data and calling the
+// ODA callback, as the si470x library does.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include <oda_decode.h>
+
+#include "check.h"
+#include "decoder_state.h"
+
+namespace {
+
+const uint8_t kItemTitle = 1;
+const uint32_t kIterations = 20000;
+
+// Iteration i sends two groups: a non-ODA group (step 2i) and then an RT+
+// group (step 2i + 1) whose title tag starts at TagStart(i). The step is
+// carried in the PI code.
+uint8_t TagStart(uint32_t i) {
+  return i % 32;
+}
+
+class Tuner {
+ public:
+  void Run(DecoderState* state) {
+    for (uint32_t i = 0; i < kIterations; i++) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rds_.pi_code = 2 * i;
+      }
+      std::this_thread::yield();  // Interleave with the UI.
+      std::lock_guard<std::mutex> lock(mutex_);
+      rds_.pi_code = 2 * i + 1;
+      struct rds_blocks blocks;
+      memset(&blocks, 0, sizeof(blocks));
+      blocks.b.val = 1 << 3;  // Item running.
+      blocks.c.val = (kItemTitle & 7) << 13 | TagStart(i) << 7;
+      const struct rds_group_type gt = {11, 'A'};
+      const struct rds_data* rds = &rds_;
+      state->Update(
+          [&](struct rds_oda_data* oda) {
+            decode_oda_blocks(oda, AID_RT_PLUS, rds, &blocks, gt);
+          },
+          rds);
+    }
+    done_ = true;
+  }
+
+  bool done() const { return done_; }
+
+ private:
+  std::mutex mutex_;
+  struct rds_data rds_ = {};
+  std::atomic<bool> done_{false};
+};
+
+// Check that the tags in |snapshot| were decoded with its RDS data, and that
+// the tags only differ from |last_start| when reported as changed.
+void CheckSnapshot(const DecoderSnapshot& snapshot,
+                   int* last_start,
+                   uint32_t* last_changes) {
+  const uint16_t step = snapshot.rds.pi_code;
+  const struct rds_oda_tag* tag =
+      find_oda_tag(&snapshot.oda.rtplus, kItemTitle);
+  if (snapshot.generation == 0) {
+    CHECK(step == 0 && tag == nullptr);
+    return;
+  }
+  // Only RT+ groups are published, each with its own RDS data.
+  CHECK(step % 2 == 1);
+  CHECK(snapshot.generation == (step - 1) / 2 + 1u);
+  CHECK(tag != nullptr);
+  if (!tag)
+    return;
+  CHECK(tag->start == TagStart((step - 1) / 2));
+  if (tag->start != *last_start)
+    CHECK(snapshot.tag_changes != *last_changes);
+  *last_start = tag->start;
+  *last_changes = snapshot.tag_changes;
+}
+
+void TestConcurrentSnapshots() {
+  DecoderState state;
+  Tuner tuner;
+  std::thread tuner_thread(&Tuner::Run, &tuner, &state);
+
+  int last_start = -1;
+  uint32_t last_changes = 0;
+  uint32_t snapshots = 0;
+  uint32_t generation = 0;
+  uint32_t updates = 0;
+  for (;;) {
+    const DecoderSnapshot& snapshot = state.Snapshot();
+    CheckSnapshot(snapshot, &last_start, &last_changes);
+    CHECK(snapshot.generation >= generation);
+    snapshots++;
+    if (snapshot.generation != generation)
+      updates++;
+    generation = snapshot.generation;
+    if (generation == kIterations)
+      break;
+    std::this_thread::yield();
+  }
+  tuner_thread.join();
+
+  // Nothing was published since, so the snapshot is unchanged.
+  CHECK(state.Snapshot().generation == kIterations);
+  printf("%u snapshots, %u with new ODA state\n", snapshots, updates);
+}
+
+// The UI holds a snapshot (as it does while drawing) until the tuner has sent
+// every group. The tuner must finish without waiting for the UI, and must not
+// write to the snapshot in the meantime.
+void TestTunerNeverWaits() {
+  DecoderState state;
+  Tuner tuner;
+  const DecoderSnapshot& held = state.Snapshot();
+  std::thread tuner_thread(&Tuner::Run, &tuner, &state);
+
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  while (!tuner.done() && std::chrono::steady_clock::now() < deadline)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  CHECK(tuner.done());
+  if (!tuner.done()) {
+    // The tuner is stuck in |state|, so neither can be destroyed.
+    tuner_thread.detach();
+    exit(TestResult());
+  }
+  tuner_thread.join();
+
+  CHECK(held.generation == 0 && held.rds.pi_code == 0);
+  CHECK(find_oda_tag(&held.oda.rtplus, kItemTitle) == nullptr);
+  const DecoderSnapshot& latest = state.Snapshot();
+  CHECK(&latest != &held);
+  CHECK(latest.generation == kIterations);
+  CHECK(latest.rds.pi_code == 2 * kIterations - 1);
+}
+
+}  // namespace
+
+int main() {
+  TestConcurrentSnapshots();
+  TestTunerNeverWaits();
+  return TestResult();
+}
@@ -0,0 +1,143 @@
+// RDS clock (CT) formatting: checks the integer MJD conversion against the
+// C library calendar and the original floating point formula, and times them.
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <string>
+
+#include <rds_util.h>
+
+#include "check.h"
+
+namespace {
+
+// The MJD of 1970-01-01.
+const int kUnixEpochMJD = 40587;
+
+// The original (Annex G) floating point MJD conversion, kept as the
+// reference. Only valid from 1900-03-01 to 2100-02-28.
+void MJD2DateFloat(int mjd, int* year, int* month, int* day) {
+  *year = (int)((mjd - 15078.2) / 365.25);
+  *month = (int)((mjd - 14956.1 - (int)(*year * 365.25)) / 30.6001);
+  *day = mjd - 14956 - (int)(*year * 365.25) - (int)(*month * 30.6001);
+  const int k = ((*month == 14) || (*month == 15)) ? 1 : 0;
+  *year += k;
+  *year += 1900;
+  *month -= 1 + k * 12;
+}
+
+// The original format_local_time() (which only handled whole hour offsets).
+void FormatLocalTimeFloat(char* buff, uint8_t bufflen, const rds_data* rds) {
+  int mjd = ((uint32_t)rds->clock.day_high) << 16 | rds->clock.day_low;
+  int hour = rds->clock.hour + rds->clock.utc_offset / 2;
+  if (hour > 23) {
+    hour -= 24;
+    mjd++;
+  } else if (hour < 0) {
+    hour += 24;
+    mjd--;
+  }
+  int year, month, day;
+  MJD2DateFloat(mjd, &year, &month, &day);
+  snprintf(buff, bufflen, "%d/%d/%04d %02d:%02d", month, day, year, hour,
+           rds->clock.minute);
+}
+
+void SetClock(struct rds_data* rds,
+              uint32_t mjd,
+              int hour,
+              int minute,
+              int utc_offset) {
+  memset(rds, 0, sizeof(*rds));
+  rds->clock.day_high = mjd >> 16;
+  rds->clock.day_low = mjd & 0xFFFF;
+  rds->clock.hour = hour;
+  rds->clock.minute = minute;
+  rds->clock.utc_offset = utc_offset;
+}
+
+std::string FormatDate(int year, int month, int day, int hour, int minute) {
+  char text[32];
+  snprintf(text, sizeof(text), "%d/%d/%04d %02d:%02d", month, day, year, hour,
+           minute);
+  return text;
+}
+
+void TestAllDates() {
+  struct local_time_cache cache;
+  memset(&cache, 0, sizeof(cache));
+  for (uint32_t mjd = 0; mjd < 0x20000; mjd++) {
+    struct rds_data rds;
+    SetClock(&rds, mjd, 12, 34, 0);
+    char text[24];
+    format_local_time(text, sizeof(text), &rds);
+
+    const time_t secs = ((time_t)mjd - kUnixEpochMJD) * 86400;
+    struct tm tm;
+    gmtime_r(&secs, &tm);
+    const std::string expected =
+        FormatDate(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, 12, 34);
+    CHECK(expected == text);
+    CHECK(expected == format_local_time_cached(&cache, &rds));
+
+    // 15079 is 1900-03-01 and 73463 2100-02-28.
+    if (mjd >= 15079 && mjd <= 73463) {
+      int year, month, day;
+      MJD2DateFloat(mjd, &year, &month, &day);
+      CHECK(FormatDate(year, month, day, 12, 34) == text);
+    }
+  }
+}
+
+void TestOffsets() {
+  struct rds_data rds;
+  char text[24];
+  // 2020-02-29 (MJD 58908) 23:50 UTC.
+  SetClock(&rds, 58908, 23, 50, 1);  // +0:30
+  format_local_time(text, sizeof(text), &rds);
+  CHECK(!strcmp(text, "3/1/2020 00:20"));
+  SetClock(&rds, 58908, 23, 50, 11);  // +5:30
+  format_local_time(text, sizeof(text), &rds);
+  CHECK(!strcmp(text, "3/1/2020 05:20"));
+  SetClock(&rds, 58908, 0, 10, -3);  // -1:30
+  format_local_time(text, sizeof(text), &rds);
+  CHECK(!strcmp(text, "2/28/2020 22:40"));
+
+  format_local_time(text, 5, &rds);
+  CHECK(!strcmp(text, "2/28"));
+}
+
+void BenchmarkFormatting() {
+  const uint32_t count = 2000000;
+  struct rds_data rds;
+  SetClock(&rds, 58908, 12, 0, 0);
+  char text[24];
+  Benchmark("format_local_time (float)", count, [&](uint32_t i) {
+    rds.clock.day_low = 50000 + i % 30000;
+    FormatLocalTimeFloat(text, sizeof(text), &rds);
+    return text[0];
+  });
+  Benchmark("format_local_time", count, [&](uint32_t i) {
+    rds.clock.day_low = 50000 + i % 30000;
+    format_local_time(text, sizeof(text), &rds);
+    return text[0];
+  });
+  struct local_time_cache cache;
+  memset(&cache, 0, sizeof(cache));
+  Benchmark("format_local_time_cached", count, [&](uint32_t i) {
+    // A new minute every 64 calls.
+    rds.clock.minute = (i >> 6) % 60;
+    return format_local_time_cached(&cache, &rds)[0];
+  });
+}
+
+}  // namespace
+
+int main() {
+  TestAllDates();
+  TestOffsets();
+  BenchmarkFormatting();
+  return TestResult();
+}
@@ -0,0 +1,127 @@
+// Batch ODA decoding: decode_oda_batch() must leave the same state as
+// decoding the groups one at a time with decode_oda_blocks(). Times both on
+// a random mix of RT+, TMC, iTunes and unregistered groups.
+
+#include <stdio.h>
+#include <string.h>
+
+#include <random>
+#include <vector>
+
+#include <oda_decode.h>
+
+#include "check.h"
+
+namespace {
+
+const uint16_t kUnknownAid = 0x1234;
+
+// Groups are decoded in batches of this many.
+const size_t kBatchSize = 256;
+
+std::vector<struct oda_group> RandomGroups(size_t count) {
+  const struct oda_group kTypes[] = {
+      {{}, {11, 'A'}, AID_RT_PLUS},
+      {{}, {8, 'A'}, AID_TMC},
+      {{}, {12, 'A'}, AID_ITUNES},
+      {{}, {13, 'A'}, kUnknownAid},
+  };
+  std::mt19937 rng(17);
+  std::vector<struct oda_group> groups(count);
+  for (struct oda_group& group : groups) {
+    group = kTypes[rng() % 4];
+    group.blocks.b.val = rng();
+    group.blocks.c.val = rng();
+    group.blocks.d.val = rng();
+  }
+  return groups;
+}
+
+bool SameTags(const struct rds_oda_tags& a, const struct rds_oda_tags& b) {
+  return a.active == b.active && a.changed == b.changed &&
+         a.count == b.count &&
+         !memcmp(a.tag, b.tag, a.count * sizeof(a.tag[0]));
+}
+
+bool SameMessage(const struct tmc_message& a, const struct tmc_message& b) {
+  return a.event == b.event && a.location == b.location &&
+         a.extent == b.extent && a.duration == b.duration &&
+         a.pos_dir == b.pos_dir && a.multi_group == b.multi_group &&
+         a.free_format_bits == b.free_format_bits &&
+         a.received == b.received && a.updated == b.updated;
+}
+
+bool SameState(const struct rds_oda_data* a, const struct rds_oda_data* b) {
+  if (!SameTags(a->rtplus, b->rtplus) || !SameTags(a->itunes, b->itunes) ||
+      a->tmc.message_cnt != b->tmc.message_cnt) {
+    return false;
+  }
+  for (uint16_t i = 0; i < a->tmc.message_cnt; i++) {
+    if (!SameMessage(a->tmc.messages[i], b->tmc.messages[i]))
+      return false;
+  }
+  for (size_t i = 0; i < 1 << ODA_SLOT_BITS; i++) {
+    if (a->registry.slot[i].pkt_count != b->registry.slot[i].pkt_count)
+      return false;
+  }
+  return true;
+}
+
+void TestSameState(const std::vector<struct oda_group>& groups,
+                   const struct rds_data& rds) {
+  struct rds_oda_data* single = create_oda_data();
+  struct rds_oda_data* batch = create_oda_data();
+  std::vector<uint32_t> scratch(kBatchSize);
+  size_t decoded = 0;
+  for (size_t i = 0; i < groups.size(); i += kBatchSize) {
+    for (size_t j = i; j < i + kBatchSize; j++) {
+      decode_oda_blocks(single, groups[j].app_id, &rds, &groups[j].blocks,
+                        groups[j].gt);
+    }
+    decoded += decode_oda_batch(batch, &rds, &groups[i], kBatchSize,
+                                scratch.data());
+    CHECK(SameState(single, batch));
+  }
+  size_t unknown = 0;
+  for (const struct oda_group& group : groups)
+    unknown += group.app_id == kUnknownAid;
+  CHECK(decoded == groups.size() - unknown);
+  CHECK(batch->tmc.message_cnt > 0);
+
+  // An empty batch.
+  CHECK(decode_oda_batch(batch, &rds, groups.data(), 0, scratch.data()) == 0);
+  CHECK(SameState(single, batch));
+  delete_oda_data(single);
+  delete_oda_data(batch);
+}
+
+// Rates are in groups per second.
+void BenchmarkBatches(const std::vector<struct oda_group>& groups,
+                      const struct rds_data& rds) {
+  struct rds_oda_data* oda = create_oda_data();
+  Benchmark("decode_oda_blocks", groups.size(), [&](uint32_t i) {
+    decode_oda_blocks(oda, groups[i].app_id, &rds, &groups[i].blocks,
+                      groups[i].gt);
+    return oda->tmc.message_cnt;
+  });
+  clear_oda_data(oda);
+  std::vector<uint32_t> scratch(kBatchSize);
+  Benchmark("decode_oda_batch", groups.size(), [&](uint32_t i) {
+    if (i % kBatchSize)
+      return 0u;
+    decode_oda_batch(oda, &rds, &groups[i], kBatchSize, scratch.data());
+    return static_cast<uint32_t>(oda->tmc.message_cnt);
+  });
+  delete_oda_data(oda);
+}
+
+}  // namespace
+
+int main() {
+  struct rds_data rds;
+  memset(&rds, 0, sizeof(rds));
+  memcpy(rds.rt.a.display, "Song - Artist", 13);
+  TestSameState(RandomGroups(kBatchSize * 64), rds);
+  BenchmarkBatches(RandomGroups(kBatchSize * 16384), rds);
+  return TestResult();
+}
@@ -0,0 +1,78 @@
+// ODA application names: every AID is looked up, so an entry added out of
+// order (which the binary search would miss) fails the count. Times
+// find_app_name() and get_app_name() against formatting the AID in hex.
+
+#include <stdio.h>
+#include <string.h>
+
+#include <oda_decode.h>
+
+#include "check.h"
+
+namespace {
+
+// The number of AIDs in kAppNames.
+const uint32_t kNumAppNames = 63;
+
+void TestAllAids() {
+  uint32_t found = 0;
+  for (uint32_t aid = 0; aid <= 0xFFFF; aid++) {
+    const char* name = find_app_name(aid);
+    if (!name)
+      continue;
+    found++;
+    CHECK(name[0] != '\0');
+  }
+  CHECK(found == kNumAppNames);
+}
+
+void TestNames() {
+  CHECK(!strcmp(find_app_name(AID_RT_PLUS), "RadioText+ (RT+)"));
+  CHECK(!strcmp(find_app_name(AID_TMC), "RDS-TMC: ALERT-C"));
+  CHECK(!strcmp(find_app_name(AID_ITUNES), "iTunes Tagging"));
+  CHECK(!strcmp(find_app_name(0x0093), "Cross referencing DAB within RDS"));
+  CHECK(!strcmp(find_app_name(0x4D87), "Radio Commerce System (RCS)"));
+  CHECK(!strcmp(find_app_name(0xFF80), "RFT+ (work title)"));
+  CHECK(find_app_name(0x0000) == nullptr);
+  CHECK(find_app_name(0xFFFF) == nullptr);
+
+  char buffer[20];
+  get_app_name(buffer, sizeof(buffer), AID_RT_PLUS);
+  CHECK(!strcmp(buffer, "RadioText+ (RT+)"));
+  get_app_name(buffer, sizeof(buffer), 0x1234);
+  CHECK(!strcmp(buffer, "0x1234"));
+  get_app_name(buffer, 6, AID_TMC);
+  CHECK(!strcmp(buffer, "RDS-T"));
+  buffer[0] = 'x';
+  get_app_name(buffer, 0, AID_TMC);
+  CHECK(buffer[0] == 'x');
+}
+
+void BenchmarkNames() {
+  // Half registered, half not.
+  const uint16_t kAids[] = {AID_RT_PLUS, 0x1234, AID_TMC, 0x0001, AID_ITUNES,
+                            0xABCD,      0x0093, 0x7000};
+  Benchmark("snprintf hex", 10000000, [&kAids](uint32_t i) {
+    char buffer[48];
+    snprintf(buffer, sizeof(buffer), "0x%X", kAids[i % 8]);
+    return static_cast<uint32_t>(buffer[2]);
+  });
+  Benchmark("find_app_name", 50000000, [&kAids](uint32_t i) {
+    const char* name = find_app_name(kAids[i % 8]);
+    return name ? static_cast<uint32_t>(name[0]) : 0u;
+  });
+  Benchmark("get_app_name", 10000000, [&kAids](uint32_t i) {
+    char buffer[48];
+    get_app_name(buffer, sizeof(buffer), kAids[i % 8]);
+    return static_cast<uint32_t>(buffer[2]);
+  });
+}
+
+}  // namespace
+
+int main() {
+  TestAllAids();
+  TestNames();
+  BenchmarkNames();
+  return TestResult();
+}
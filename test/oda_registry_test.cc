@@ -0,0 +1,277 @@
+// ODA decoder registry: registering decoders at runtime, the search for a
+// new perfect hash seed when AIDs collide, the decoder and state pool limits,
+// per-AID packet counts and clearing decoder state.
+
+#include <string.h>
+
+#include <vector>
+
+#include <oda_decode.h>
+
+#include "check.h"
+
+namespace {
+
+// A test decoder's state: the groups it was given.
+struct TestState {
+  uint32_t groups;
+  uint16_t last_b;
+  uint8_t cleared;
+};
+
+void DecodeTest(struct rds_oda_data* oda_data,
+                void* state,
+                const struct rds_data* rds,
+                const struct rds_blocks* blocks,
+                struct rds_group_type gt) {
+  (void)oda_data;
+  (void)rds;
+  (void)gt;
+  struct TestState* test = static_cast<struct TestState*>(state);
+  test->groups++;
+  test->last_b = blocks->b.val;
+}
+
+void ClearTest(struct rds_oda_data* oda_data, void* state) {
+  (void)oda_data;
+  struct TestState* test = static_cast<struct TestState*>(state);
+  const uint8_t cleared = test->cleared;
+  memset(test, 0, sizeof(*test));
+  test->cleared = cleared + 1;
+}
+
+void DecodeNothing(struct rds_oda_data* oda_data,
+                   void* state,
+                   const struct rds_data* rds,
+                   const struct rds_blocks* blocks,
+                   struct rds_group_type gt) {
+  (void)oda_data;
+  (void)state;
+  (void)rds;
+  (void)blocks;
+  (void)gt;
+}
+
+struct Decoders {
+  // Decoders are referenced, not copied, so keep them in a stable array.
+  explicit Decoders(size_t count) : decoders(count) {}
+
+  const struct oda_decoder* Make(size_t idx,
+                                 uint16_t app_id,
+                                 uint16_t state_size) {
+    struct oda_decoder* decoder = &decoders[idx];
+    decoder->app_id = app_id;
+    decoder->decode = state_size ? DecodeTest : DecodeNothing;
+    decoder->clear = nullptr;
+    decoder->state_size = state_size;
+    return decoder;
+  }
+
+  std::vector<struct oda_decoder> decoders;
+};
+
+const uint16_t kBuiltinAids[] = {AID_RT_PLUS, AID_TMC, AID_ITUNES};
+
+void Decode(struct rds_oda_data* oda, uint16_t app_id, uint16_t b) {
+  struct rds_data rds;
+  memset(&rds, 0, sizeof(rds));
+  struct rds_blocks blocks;
+  memset(&blocks, 0, sizeof(blocks));
+  blocks.b.val = b;
+  const struct rds_group_type gt = {13, 'A'};
+  decode_oda_blocks(oda, app_id, &rds, &blocks, gt);
+}
+
+uint8_t SlotIndex(const struct rds_oda_data* oda, uint16_t app_id) {
+  return static_cast<uint32_t>(app_id * oda->registry.seed) >>
+         (32 - ODA_SLOT_BITS);
+}
+
+// Every registered decoder is in the slot its AID hashes to.
+bool IsPerfectlyHashed(const struct rds_oda_data* oda) {
+  uint8_t count = 0;
+  for (size_t i = 0; i < 1 << ODA_SLOT_BITS; i++) {
+    const struct oda_decoder* decoder = oda->registry.slot[i].decoder;
+    if (!decoder)
+      continue;
+    count++;
+    if (SlotIndex(oda, decoder->app_id) != i)
+      return false;
+  }
+  return count == oda->registry.count;
+}
+
+void TestRegister() {
+  struct rds_oda_data* oda = create_oda_data();
+  CHECK(oda->registry.count == 3);
+  CHECK(IsPerfectlyHashed(oda));
+  for (uint16_t app_id : kBuiltinAids)
+    CHECK(get_oda_decoder_state(oda, app_id) == nullptr);
+
+  const struct oda_decoder kDecoder = {0x1234, DecodeTest, ClearTest,
+                                       sizeof(struct TestState)};
+  CHECK(get_oda_decoder_state(oda, 0x1234) == nullptr);
+  CHECK(register_oda_decoder(oda, &kDecoder));
+  CHECK(oda->registry.count == 4);
+  CHECK(IsPerfectlyHashed(oda));
+  struct TestState* state =
+      static_cast<struct TestState*>(get_oda_decoder_state(oda, 0x1234));
+  CHECK(state != nullptr);
+  if (!state) {
+    delete_oda_data(oda);
+    return;
+  }
+  CHECK(state->groups == 0 && state->last_b == 0);
+
+  Decode(oda, 0x1234, 0xBEEF);
+  CHECK(state->groups == 1 && state->last_b == 0xBEEF);
+
+  // Already registered, and the reserved AID zero.
+  CHECK(!register_oda_decoder(oda, &kDecoder));
+  const struct oda_decoder kZero = {0, DecodeNothing, nullptr, 0};
+  CHECK(!register_oda_decoder(oda, &kZero));
+  CHECK(oda->registry.count == 4);
+
+  // The clear function resets the state, and the packet count is reset.
+  clear_oda_data(oda);
+  CHECK(state->groups == 0 && state->cleared == 1);
+  CHECK(get_oda_packet_count(oda, 0x1234) == 0);
+  delete_oda_data(oda);
+}
+
+// An AID which hashes to an existing decoder's slot forces a new seed, and
+// every decoder (with its state and packet count) moves to its new slot.
+void TestCollision() {
+  struct rds_oda_data* oda = create_oda_data();
+  const uint32_t old_seed = oda->registry.seed;
+  uint16_t app_id = 1;
+  while (SlotIndex(oda, app_id) != SlotIndex(oda, AID_RT_PLUS))
+    app_id++;
+  CHECK(app_id != AID_RT_PLUS);
+  Decode(oda, AID_RT_PLUS, 0);
+  Decode(oda, AID_TMC, 0);
+  Decode(oda, AID_TMC, 0);
+
+  const struct oda_decoder kDecoder = {app_id, DecodeTest, nullptr,
+                                       sizeof(struct TestState)};
+  CHECK(register_oda_decoder(oda, &kDecoder));
+  CHECK(oda->registry.seed != old_seed);
+  CHECK(IsPerfectlyHashed(oda));
+  CHECK(SlotIndex(oda, app_id) != SlotIndex(oda, AID_RT_PLUS));
+  CHECK(get_oda_packet_count(oda, AID_RT_PLUS) == 1);
+  CHECK(get_oda_packet_count(oda, AID_TMC) == 2);
+  CHECK(get_oda_packet_count(oda, AID_ITUNES) == 0);
+
+  Decode(oda, app_id, 7);
+  const struct TestState* state =
+      static_cast<struct TestState*>(get_oda_decoder_state(oda, app_id));
+  CHECK(state && state->groups == 1 && state->last_b == 7);
+  CHECK(get_oda_packet_count(oda, app_id) == 1);
+  delete_oda_data(oda);
+}
+
+// At most ODA_MAX_DECODERS decoders can be registered.
+void TestMaxDecoders() {
+  struct rds_oda_data* oda = create_oda_data();
+  Decoders decoders(ODA_MAX_DECODERS + 1);
+  uint16_t app_id = 0x1000;
+  size_t registered = oda->registry.count;
+  for (size_t i = 0; registered < ODA_MAX_DECODERS; i++, app_id += 0x111) {
+    CHECK(register_oda_decoder(oda, decoders.Make(i, app_id, 0)));
+    registered++;
+  }
+  CHECK(oda->registry.count == ODA_MAX_DECODERS);
+  CHECK(IsPerfectlyHashed(oda));
+  CHECK(!register_oda_decoder(oda,
+                              decoders.Make(ODA_MAX_DECODERS, app_id, 0)));
+  CHECK(oda->registry.count == ODA_MAX_DECODERS);
+  CHECK(get_oda_packet_count(oda, app_id) == 0);
+  Decode(oda, app_id, 0);
+  CHECK(get_oda_packet_count(oda, app_id) == 0);
+  delete_oda_data(oda);
+}
+
+// State blocks are 8-byte aligned, and come from a pool of
+// ODA_STATE_POOL_SIZE bytes.
+void TestStatePool() {
+  struct rds_oda_data* oda = create_oda_data();
+  Decoders decoders(4);
+  CHECK(register_oda_decoder(oda, decoders.Make(0, 0x1001, 3)));
+  CHECK(oda->registry.pool_used == 8);
+  const size_t kRest = ODA_STATE_POOL_SIZE - 8;
+  CHECK(!register_oda_decoder(oda, decoders.Make(1, 0x1002, kRest + 1)));
+  CHECK(get_oda_decoder_state(oda, 0x1002) == nullptr);
+  CHECK(register_oda_decoder(oda, decoders.Make(2, 0x1003, kRest)));
+  CHECK(oda->registry.pool_used == ODA_STATE_POOL_SIZE);
+
+  // The pool is full, but decoders without state can still register.
+  CHECK(!register_oda_decoder(oda, decoders.Make(3, 0x1004, 1)));
+  CHECK(register_oda_decoder(oda, decoders.Make(3, 0x1004, 0)));
+
+  uint8_t* first = static_cast<uint8_t*>(get_oda_decoder_state(oda, 0x1001));
+  uint8_t* second = static_cast<uint8_t*>(get_oda_decoder_state(oda, 0x1003));
+  CHECK(first && second && second - first == 8);
+  CHECK(reinterpret_cast<uintptr_t>(second) % 8 == 0);
+
+  // Without a clear function the state is zeroed.
+  if (second) {
+    memset(second, 0xA5, kRest);
+    clear_oda_data(oda);
+    CHECK(second[0] == 0 && second[kRest - 1] == 0);
+  }
+  delete_oda_data(oda);
+}
+
+// Each AID counts the groups decoded for it (singly or in batches), and
+// groups for unregistered AIDs aren't counted.
+void TestPacketCounts() {
+  struct rds_oda_data* oda = create_oda_data();
+  Decoders decoders(1);
+  CHECK(register_oda_decoder(
+      oda, decoders.Make(0, 0x4321, sizeof(struct TestState))));
+  const uint16_t kAids[] = {AID_RT_PLUS, AID_TMC, AID_ITUNES, 0x4321};
+  std::vector<struct oda_group> groups;
+  for (uint32_t i = 0; i < 100; i++) {
+    const uint16_t app_id = i % 7 == 0 ? 0x9999 : kAids[i % 4];
+    Decode(oda, app_id, 0);
+    struct oda_group group;
+    memset(&group, 0, sizeof(group));
+    group.app_id = app_id;
+    group.gt.code = 13;
+    group.gt.version = 'A';
+    groups.push_back(group);
+  }
+  uint32_t expected[4] = {0, 0, 0, 0};
+  for (uint32_t i = 0; i < 100; i++) {
+    if (i % 7)
+      expected[i % 4]++;
+  }
+  for (int i = 0; i < 4; i++)
+    CHECK(get_oda_packet_count(oda, kAids[i]) == expected[i]);
+  CHECK(get_oda_packet_count(oda, 0x9999) == 0);
+
+  struct rds_data rds;
+  memset(&rds, 0, sizeof(rds));
+  std::vector<uint32_t> scratch(groups.size());
+  CHECK(decode_oda_batch(oda, &rds, groups.data(), groups.size(),
+                         scratch.data()) ==
+        expected[0] + expected[1] + expected[2] + expected[3]);
+  for (int i = 0; i < 4; i++)
+    CHECK(get_oda_packet_count(oda, kAids[i]) == 2 * expected[i]);
+
+  clear_oda_data(oda);
+  for (int i = 0; i < 4; i++)
+    CHECK(get_oda_packet_count(oda, kAids[i]) == 0);
+  delete_oda_data(oda);
+}
+
+}  // namespace
+
+int main() {
+  TestRegister();
+  TestCollision();
+  TestMaxDecoders();
+  TestStatePool();
+  TestPacketCounts();
+  return TestResult();
+}
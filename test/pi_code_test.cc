@@ -0,0 +1,642 @@
+// PI code decoding: checks the call sign table against the switch it
+// replaced, the rest of world (ECC) decoding and the PI cache's ordering,
+// eviction and hit/miss counts, and times the decoding. The rest of
+// world decoding is also timed on the PI codes and ECCs of the Germany RDS Spy
+// logs (the directory given as the first argument), if present.
+
+#include <dirent.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <rds_spy_reader.h>
+#include <rds_util.h>
+
+#include "check.h"
+
+namespace {
+
+// The original switch based decode_pi_US() (before the call sign table), kept
+// as the reference.
+bool DecodePiUSSwitch(char* buffer, size_t buffer_len, uint16_t picode) {
+  if (buffer_len < 5)
+    return false;
+
+  if ((picode & 0xAF00) == 0xAF00)
+    picode = (picode & 0x00FF) << 8;
+  if ((picode & 0xA000) == 0xA000)
+    picode = ((picode & 0x0F00) << 4) | (picode & 0xFF);
+
+  if (picode > 4095 && picode < 39247) {
+    if (picode > 21671) {
+      buffer[0] = 'W';
+      picode -= 21672;
+    } else {
+      buffer[0] = 'K';
+      picode -= 4096;
+    }
+    const uint16_t call2 = picode / 676;
+    picode -= 676 * call2;
+    const uint16_t call3 = picode / 26;
+    const uint16_t call4 = picode - (26 * call3);
+
+    buffer[1] = 'A' + call2;
+    buffer[2] = 'A' + call3;
+    buffer[3] = 'A' + call4;
+    buffer[4] = '\0';
+    return true;
+  }
+
+  switch (picode) {
+    case 49829:
+      strncpy(buffer, "CIMF", buffer_len);
+      break;
+    case 17185:
+      strncpy(buffer, "CJPT", buffer_len);
+      break;
+    case 39248:
+      strncpy(buffer, "KEX", buffer_len);
+      break;
+    case 39249:
+      strncpy(buffer, "KFH", buffer_len);
+      break;
+    case 39253:
+      strncpy(buffer, "KGU", buffer_len);
+      break;
+    case 39254:
+      strncpy(buffer, "KGW", buffer_len);
+      break;
+    case 39255:
+      strncpy(buffer, "KGY", buffer_len);
+      break;
+    case 39256:
+      strncpy(buffer, "KID", buffer_len);
+      break;
+    case 39257:
+      strncpy(buffer, "KIT", buffer_len);
+      break;
+    case 39258:
+      strncpy(buffer, "KJR", buffer_len);
+      break;
+    case 39259:
+      strncpy(buffer, "KLO", buffer_len);
+      break;
+    case 39260:
+      strncpy(buffer, "KLZ", buffer_len);
+      break;
+    case 39261:
+      strncpy(buffer, "KMA", buffer_len);
+      break;
+    case 39262:
+      strncpy(buffer, "KMJ", buffer_len);
+      break;
+    case 39263:
+      strncpy(buffer, "KNX", buffer_len);
+      break;
+    case 39264:
+      strncpy(buffer, "KOA", buffer_len);
+      break;
+    case 39268:
+      strncpy(buffer, "KQV", buffer_len);
+      break;
+    case 39269:
+      strncpy(buffer, "KSL", buffer_len);
+      break;
+    case 39270:
+      strncpy(buffer, "KUJ", buffer_len);
+      break;
+    case 39271:
+      strncpy(buffer, "KVI", buffer_len);
+      break;
+    case 39272:
+      strncpy(buffer, "KWG", buffer_len);
+      break;
+    case 39275:
+      strncpy(buffer, "KYW", buffer_len);
+      break;
+    case 39277:
+      strncpy(buffer, "WBZ", buffer_len);
+      break;
+    case 39278:
+      strncpy(buffer, "WDZ", buffer_len);
+      break;
+    case 39279:
+      strncpy(buffer, "WEW", buffer_len);
+      break;
+    case 39281:
+      strncpy(buffer, "WGL", buffer_len);
+      break;
+    case 39282:
+      strncpy(buffer, "WGN", buffer_len);
+      break;
+    case 39283:
+      strncpy(buffer, "WGR", buffer_len);
+      break;
+    case 39285:
+      strncpy(buffer, "WHA", buffer_len);
+      break;
+    case 39286:
+      strncpy(buffer, "WHB", buffer_len);
+      break;
+    case 39287:
+      strncpy(buffer, "WHK", buffer_len);
+      break;
+    case 39288:
+      strncpy(buffer, "WHO", buffer_len);
+      break;
+    case 39290:
+      strncpy(buffer, "WIP", buffer_len);
+      break;
+    case 39291:
+      strncpy(buffer, "WJR", buffer_len);
+      break;
+    case 39292:
+      strncpy(buffer, "WKY", buffer_len);
+      break;
+    case 39293:
+      strncpy(buffer, "WLS", buffer_len);
+      break;
+    case 39294:
+      strncpy(buffer, "WLW", buffer_len);
+      break;
+    case 39297:
+      strncpy(buffer, "WOC", buffer_len);
+      break;
+    case 39299:
+      strncpy(buffer, "WOL", buffer_len);
+      break;
+    case 39300:
+      strncpy(buffer, "WOR", buffer_len);
+      break;
+    case 39304:
+      strncpy(buffer, "WWJ", buffer_len);
+      break;
+    case 39305:
+      strncpy(buffer, "WWL", buffer_len);
+      break;
+    case 39312:
+      strncpy(buffer, "KDB", buffer_len);
+      break;
+    case 39313:
+      strncpy(buffer, "KGB", buffer_len);
+      break;
+    case 39314:
+      strncpy(buffer, "KOY", buffer_len);
+      break;
+    case 39315:
+      strncpy(buffer, "KPQ", buffer_len);
+      break;
+    case 39316:
+      strncpy(buffer, "KSD", buffer_len);
+      break;
+    case 39317:
+      strncpy(buffer, "KUT", buffer_len);
+      break;
+    case 39318:
+      strncpy(buffer, "KXL", buffer_len);
+      break;
+    case 39319:
+      strncpy(buffer, "KXO", buffer_len);
+      break;
+    case 39321:
+      strncpy(buffer, "WBT", buffer_len);
+      break;
+    case 39322:
+      strncpy(buffer, "WGH", buffer_len);
+      break;
+    case 39323:
+      strncpy(buffer, "WGY", buffer_len);
+      break;
+    case 39324:
+      strncpy(buffer, "WHP", buffer_len);
+      break;
+    case 39325:
+      strncpy(buffer, "WIL", buffer_len);
+      break;
+    case 39326:
+      strncpy(buffer, "WMC", buffer_len);
+      break;
+    case 39327:
+      strncpy(buffer, "WMT", buffer_len);
+      break;
+    case 39328:
+      strncpy(buffer, "WOI", buffer_len);
+      break;
+    case 39329:
+      strncpy(buffer, "WOW", buffer_len);
+      break;
+    case 39330:
+      strncpy(buffer, "WRR", buffer_len);
+      break;
+    case 39331:
+      strncpy(buffer, "WSB", buffer_len);
+      break;
+    case 39332:
+      strncpy(buffer, "WSM", buffer_len);
+      break;
+    case 39333:  // Also XHSR?
+      strncpy(buffer, "KBW", buffer_len);
+      break;
+    case 39334:
+      strncpy(buffer, "KCY", buffer_len);
+      break;
+    case 39335:
+      strncpy(buffer, "KDF", buffer_len);
+      break;
+    case 39338:
+      strncpy(buffer, "KHQ", buffer_len);
+      break;
+    case 39339:
+      strncpy(buffer, "KOB", buffer_len);
+      break;
+    case 39347:
+      strncpy(buffer, "WIS", buffer_len);
+      break;
+    case 39348:
+      strncpy(buffer, "WJW", buffer_len);
+      break;
+    case 39349:
+      strncpy(buffer, "WJZ", buffer_len);
+      break;
+    case 39353:
+      strncpy(buffer, "WRC", buffer_len);
+      break;
+    case 26542:
+      strncpy(buffer, "WHFI/CHFI", buffer_len);
+      break;
+    case 39250:
+      strncpy(buffer, "KFI/CJBC", buffer_len);
+      break;
+    case 49160:
+      strncpy(buffer, "CJBC-1", buffer_len);
+      break;
+    case 49158:
+      strncpy(buffer, "CBCK", buffer_len);
+      break;
+    case 52010:
+      strncpy(buffer, "CBLG", buffer_len);
+      break;
+    case 52007:
+      strncpy(buffer, "CBLJ", buffer_len);
+      break;
+    case 52012:
+      strncpy(buffer, "CBQT", buffer_len);
+      break;
+    case 52009:
+      strncpy(buffer, "CBEB", buffer_len);
+      break;
+    case 28378:
+      strncpy(buffer, "WJXY/CJXY", buffer_len);
+      break;
+    case 39251:
+      strncpy(buffer, "KGA/CBCx", buffer_len);
+      break;
+    case 39252:
+      strncpy(buffer, "KGO/CBCP", buffer_len);
+      break;
+    case 941:
+      strncpy(buffer, "CKGE", buffer_len);
+      break;
+    case 16416:
+      strncpy(buffer, "KSFW/CBLA", buffer_len);
+      break;
+    case 25414:
+      strncpy(buffer, "WFNY/CFNY", buffer_len);
+      break;
+    case 27382:
+      strncpy(buffer, "WILQ/CILQ", buffer_len);
+      break;
+    case 27424:
+      strncpy(buffer, "WING/CING", buffer_len);
+      break;
+    case 26428:
+      strncpy(buffer, "WHAY/CHAY", buffer_len);
+      break;
+    case 52033:
+      strncpy(buffer, "CBA-FM", buffer_len);
+      break;
+    case 52034:
+      strncpy(buffer, "CBCT", buffer_len);
+      break;
+    case 52045:
+      strncpy(buffer, "CBHM", buffer_len);
+      break;
+    case 45084:
+      strncpy(buffer, "CIQM", buffer_len);
+      break;
+    case 51806:
+      strncpy(buffer, "CHNI, CJNI, or CKNI", buffer_len);
+      break;
+    case 12289:
+      strncpy(buffer, "KLAS (Jamaica)", buffer_len);
+      break;
+    case 7877:
+      strncpy(buffer, "CFPL", buffer_len);
+      break;
+    case 7760:
+      strncpy(buffer, "ZFKY (Cayman Is.)", buffer_len);
+      break;
+    case 8151:
+      strncpy(buffer, "ZFCC (Cayman Is.)", buffer_len);
+      break;
+    case 12656:
+      strncpy(buffer, "WAVW", buffer_len);
+      break;
+    case 7908:
+      strncpy(buffer, "KTCZ", buffer_len);
+      break;
+    case 42149:
+      strncpy(buffer, "KSKZ or KWKR", buffer_len);
+      break;
+    case 45313:
+      strncpy(buffer, "XHCTO", buffer_len);
+      break;
+    case 34784:
+      strncpy(buffer, "XHTRR", buffer_len);
+      break;
+    default:
+      return false;
+  }
+  buffer[buffer_len - 1] = '\0';
+  return true;
+}
+
+void TestCallSigns() {
+  for (size_t buffer_len : {5, 6, 8, 13, 32}) {
+    for (uint32_t pi_code = 0; pi_code <= 0xFFFF; pi_code++) {
+      char expected[32];
+      char actual[32];
+      memset(expected, 0, sizeof(expected));
+      memset(actual, 0, sizeof(actual));
+      const bool expected_ok =
+          DecodePiUSSwitch(expected, buffer_len, pi_code);
+      const bool actual_ok =
+          decode_pi_code(actual, buffer_len, pi_code, REGION_US);
+      CHECK(expected_ok == actual_ok);
+      if (expected_ok && actual_ok)
+        CHECK(!strcmp(expected, actual));
+    }
+  }
+
+  size_t len;
+  const char* call_sign = get_pi_call_sign_US(49829, &len);
+  CHECK(call_sign && std::string(call_sign, len) == "CIMF");
+  CHECK(get_pi_call_sign_US(0x2144, &len) == nullptr);  // Derived (KGOA).
+}
+
+void BenchmarkCallSigns() {
+  // The table entries are what the change affects, so benchmark the PI codes
+  // of the special call signs (which the switch has to search for), in a
+  // shuffled order so that the branches can't simply be learnt.
+  std::vector<uint16_t> pi_codes;
+  for (uint32_t pi_code = 0; pi_code <= 0xFFFF; pi_code++) {
+    if (get_pi_call_sign_US(pi_code, nullptr))
+      pi_codes.push_back(pi_code);
+  }
+  std::vector<uint16_t> shuffled(4096);
+  for (size_t i = 0; i < shuffled.size(); i++)
+    shuffled[i] = pi_codes[(i * 2654435761u >> 7) % pi_codes.size()];
+  pi_codes.swap(shuffled);
+
+  const uint32_t count = 2000000;
+  char buffer[16];
+  Benchmark("call sign switch", count, [&](uint32_t i) {
+    const uint16_t pi_code = pi_codes[i % pi_codes.size()];
+    return DecodePiUSSwitch(buffer, sizeof(buffer), pi_code) + buffer[0];
+  });
+  Benchmark("call sign table", count, [&](uint32_t i) {
+    const uint16_t pi_code = pi_codes[i % pi_codes.size()];
+    return decode_pi_code(buffer, sizeof(buffer), pi_code, REGION_US) +
+           buffer[0];
+  });
+  Benchmark("call sign table (no copy)", count, [&](uint32_t i) {
+    size_t len;
+    return get_pi_call_sign_US(pi_codes[i % pi_codes.size()], &len)[0] + len;
+  });
+}
+
+std::string DecodeROW(uint16_t pi_code, uint8_t ecc) {
+  char buffer[PI_CACHE_TEXT_LEN];
+  if (!decode_pi_code_ecc(buffer, sizeof(buffer), pi_code, ecc,
+                          REGION_EUROPE)) {
+    return "<none>";
+  }
+  return buffer;
+}
+
+void TestRestOfWorld() {
+  CHECK(DecodeROW(0xD32A, 0xE0) == "DE Supra-regional #2A");
+  CHECK(DecodeROW(0xC201, 0xE1) == "GB National #01");
+  CHECK(DecodeROW(0xF201, 0xE1) == "FR National #01");
+  // Without a (European) ECC only the country nibble is known.
+  CHECK(DecodeROW(0xD32A, 0) == "[D] Supra-regional #2A");
+  CHECK(DecodeROW(0xD32A, 0xA0) == "[D] Supra-regional #2A");
+  // Unallocated country codes.
+  CHECK(DecodeROW(0x0123, 0xE0) == "[0] International #23");
+  CHECK(DecodeROW(0, 0xE0) == "<none>");
+
+  CHECK(!strcmp(get_pi_country_code(0xD000, 0xE0), "DE"));
+  CHECK(get_pi_country_code(0xE000, 0xE0) == nullptr);
+  CHECK(get_pi_country_code(0xD000, 0xE5) == nullptr);
+
+  // Truncation always leaves a terminated string.
+  char small[6];
+  CHECK(decode_pi_code_ecc(small, sizeof(small), 0xD32A, 0xE0, REGION_EUROPE));
+  CHECK(!strcmp(small, "DE Su"));
+}
+
+void TestRdsEcc() {
+  struct pi_decode_cache cache;
+  clear_pi_decode_cache(&cache);
+  struct rds_data rds;
+  memset(&rds, 0, sizeof(rds));
+  rds.pi_code = 0xD32A;
+  CHECK(!strcmp(decode_rds_pi_code_cached(&cache, &rds, REGION_EUROPE),
+                "[D] Supra-regional #2A"));
+
+  // Group 1A variant 0 carries the ECC.
+  rds.valid_values |= RDS_SLC;
+  rds.slc.variant_code = SLC_VARIANT_PAGING;
+  rds.slc.data.paging.country_code = 0xE0;
+  CHECK(!strcmp(decode_rds_pi_code_cached(&cache, &rds, REGION_EUROPE),
+                "DE Supra-regional #2A"));
+
+  // It is remembered while other variants are received...
+  rds.slc.variant_code = SLC_VARIANT_PAGING + 3;
+  rds.slc.data.tmc_id = 0x1234;
+  CHECK(!strcmp(decode_rds_pi_code_cached(&cache, &rds, REGION_EUROPE),
+                "DE Supra-regional #2A"));
+
+  // ...but not once the station changes.
+  rds.pi_code = 0xF201;
+  CHECK(!strcmp(decode_rds_pi_code_cached(&cache, &rds, REGION_EUROPE),
+                "[F] National #01"));
+
+  // The ECC is not used in the US.
+  rds.pi_code = 0x2144;
+  CHECK(!strcmp(decode_rds_pi_code_cached(&cache, &rds, REGION_US), "KGOA"));
+}
+
+// The cached texts, most recently used first.
+std::vector<std::string> CacheOrder(const struct pi_decode_cache& cache) {
+  std::vector<std::string> order;
+  for (uint8_t i = 0; i < cache.count; i++)
+    order.push_back(cache.entry[i].text);
+  return order;
+}
+
+void TestPiCache() {
+  struct pi_decode_cache cache;
+  clear_pi_decode_cache(&cache);
+  CHECK(cache.count == 0 && cache.hits == 0 && cache.misses == 0);
+
+  // Derived call signs: 0x1000 + i is KAA(A + i).
+  std::vector<std::string> expected;
+  for (uint16_t i = 0; i < PI_CACHE_SIZE; i++) {
+    const std::string text = decode_pi_code_cached(&cache, 0x1000 + i, 0,
+                                                   REGION_US);
+    CHECK(text == std::string("KAA") + static_cast<char>('A' + i));
+    expected.insert(expected.begin(), text);
+  }
+  CHECK(cache.count == PI_CACHE_SIZE);
+  CHECK(cache.hits == 0 && cache.misses == PI_CACHE_SIZE);
+  CHECK(CacheOrder(cache) == expected);
+
+  // The current station is a hit, and stays in front.
+  CHECK(!strcmp(decode_pi_code_cached(&cache, 0x1007, 0, REGION_US), "KAAH"));
+  CHECK(cache.hits == 1 && CacheOrder(cache) == expected);
+
+  // An older entry is a hit, and moves to the front.
+  CHECK(!strcmp(decode_pi_code_cached(&cache, 0x1002, 0, REGION_US), "KAAC"));
+  CHECK(cache.hits == 2 && cache.misses == PI_CACHE_SIZE);
+  expected.erase(std::find(expected.begin(), expected.end(), "KAAC"));
+  expected.insert(expected.begin(), "KAAC");
+  CHECK(CacheOrder(cache) == expected);
+
+  // A new PI code evicts the least recently used (KAAA).
+  CHECK(expected.back() == "KAAA");
+  CHECK(!strcmp(decode_pi_code_cached(&cache, 0x1008, 0, REGION_US), "KAAI"));
+  CHECK(cache.count == PI_CACHE_SIZE && cache.misses == PI_CACHE_SIZE + 1);
+  expected.pop_back();
+  expected.insert(expected.begin(), "KAAI");
+  CHECK(CacheOrder(cache) == expected);
+  CHECK(!strcmp(decode_pi_code_cached(&cache, 0x1000, 0, REGION_US), "KAAA"));
+  CHECK(cache.misses == PI_CACHE_SIZE + 2);
+  CHECK(CacheOrder(cache).back() == "KAAD");
+
+  // The ECC and region are part of the key.
+  CHECK(!strcmp(decode_pi_code_cached(&cache, 0xD32A, 0, REGION_EUROPE),
+                "[D] Supra-regional #2A"));
+  CHECK(!strcmp(decode_pi_code_cached(&cache, 0xD32A, 0xE0, REGION_EUROPE),
+                "DE Supra-regional #2A"));
+  CHECK(!strcmp(decode_pi_code_cached(&cache, 0x1000, 0, REGION_EUROPE),
+                "[1] Local #00"));
+  CHECK(cache.misses == PI_CACHE_SIZE + 5);
+
+  // PI codes which can't be decoded are cached as empty.
+  CHECK(!strcmp(decode_pi_code_cached(&cache, 0, 0, REGION_US), ""));
+  CHECK(!strcmp(decode_pi_code_cached(&cache, 0, 0, REGION_US), ""));
+  CHECK(cache.misses == PI_CACHE_SIZE + 6 && cache.hits == 3);
+
+  clear_pi_decode_cache(&cache);
+  CHECK(cache.count == 0 && cache.hits == 0 && cache.misses == 0);
+}
+
+void BenchmarkRestOfWorld() {
+  char buffer[PI_CACHE_TEXT_LEN];
+  Benchmark("rest of world decode", 2000000, [&](uint32_t i) {
+    const uint16_t pi_code = (i * 2654435761u >> 8) | 0x1000;
+    return decode_pi_code_ecc(buffer, sizeof(buffer), pi_code, 0xE0 + i % 5,
+                              REGION_EUROPE) +
+           buffer[0];
+  });
+}
+
+struct PiCode {
+  uint16_t pi_code;
+  uint8_t ecc;  // The last ECC received with |pi_code|, or zero.
+};
+
+// Read the PI code of every group in the RDS Spy logs in |dir|, with the ECC
+// from group 1A variant 0. Returns nothing if |dir| can't be read.
+std::vector<PiCode> ReadLogPiCodes(const char* dir_path) {
+  std::vector<PiCode> pi_codes;
+  DIR* dir = opendir(dir_path);
+  if (!dir)
+    return pi_codes;
+  std::vector<std::string> fnames;
+  struct dirent* ent;
+  while ((ent = readdir(dir)) != NULL) {
+    if (ent->d_name[0] != '.')
+      fnames.push_back(std::string(dir_path) + '/' + ent->d_name);
+  }
+  closedir(dir);
+  std::sort(fnames.begin(), fnames.end());
+  for (const std::string& fname : fnames) {
+    struct rds_spy_log* log = open_rds_spy_log(fname.c_str());
+    if (!log)
+      continue;
+    struct rds_spy_cursor cursor;
+    init_rds_spy_cursor(log, &cursor);
+    struct rds_blocks blocks;
+    PiCode pi_code = {0, 0};
+    while (next_rds_spy_blocks(&cursor, &blocks)) {
+      if (blocks.a.errors)
+        continue;
+      if (blocks.a.val != pi_code.pi_code) {
+        pi_code.pi_code = blocks.a.val;
+        pi_code.ecc = 0;
+      }
+      // Group 1A (type 1, version A), variant 0 (paging + ECC).
+      if (!blocks.b.errors && !blocks.c.errors &&
+          (blocks.b.val & 0xF800) == 0x1000 &&
+          (blocks.c.val & 0x7000) == 0) {
+        pi_code.ecc = blocks.c.val & 0xFF;
+      }
+      pi_codes.push_back(pi_code);
+    }
+    close_rds_spy_log(log);
+  }
+  return pi_codes;
+}
+
+// Rates are in groups per second. Stations repeat their PI code in every
+// group, which is what the cache is for.
+void BenchmarkLogs(const char* dir) {
+  const std::vector<PiCode> pi_codes = ReadLogPiCodes(dir);
+  if (pi_codes.empty()) {
+    printf("No RDS Spy logs in %s: skipping the log benchmark\n", dir);
+    return;
+  }
+  const uint32_t count = pi_codes.size();
+  char buffer[PI_CACHE_TEXT_LEN];
+  Benchmark("log decode", count, [&](uint32_t i) {
+    return decode_pi_code_ecc(buffer, sizeof(buffer), pi_codes[i].pi_code,
+                              pi_codes[i].ecc, REGION_EUROPE) +
+           buffer[0];
+  });
+  struct pi_decode_cache cache;
+  clear_pi_decode_cache(&cache);
+  Benchmark("log decode (cached)", count, [&](uint32_t i) {
+    return static_cast<uint32_t>(
+        decode_pi_code_cached(&cache, pi_codes[i].pi_code, pi_codes[i].ecc,
+                              REGION_EUROPE)[0]);
+  });
+  printf("%u groups, %u cache hits, %u misses\n", count, cache.hits,
+         cache.misses);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  TestCallSigns();
+  TestRestOfWorld();
+  TestRdsEcc();
+  TestPiCache();
+  BenchmarkCallSigns();
+  BenchmarkRestOfWorld();
+  BenchmarkLogs(argc > 1 ? argv[1] : "../rds-spy-logs/Germany");
+  return TestResult();
+}
@@ -0,0 +1,82 @@
+// PTY names: checks both regions' long and short name tables, which table
+// each tuner region uses, and the bounds check. Also built with
+// RDS_UTIL_PTY_RBDS_ONLY and RDS_UTIL_PTY_RDS_ONLY, where every region must
+// get the one table which is built in.
+
+#include <string.h>
+
+#include <rds_util.h>
+
+#include "check.h"
+
+namespace {
+
+const enum si470x_region_t kRegions[] = {REGION_US, REGION_EUROPE,
+                                         REGION_JAPAN};
+
+// Whether |region| gets the RBDS (US) names.
+bool UsesRBDS(enum si470x_region_t region) {
+#if defined(RDS_UTIL_PTY_RBDS_ONLY)
+  (void)region;
+  return true;
+#elif defined(RDS_UTIL_PTY_RDS_ONLY)
+  (void)region;
+  return false;
+#else
+  return region == REGION_US;
+#endif
+}
+
+bool IsName(const char* name, const char* expected) {
+  return name && !strcmp(name, expected);
+}
+
+void TestNames() {
+  for (enum si470x_region_t region : kRegions) {
+    const bool rbds = UsesRBDS(region);
+    CHECK(IsName(get_pty_code_name(0, region), ""));
+    CHECK(IsName(get_pty_code_short_name(0, region), ""));
+    CHECK(IsName(get_pty_code_name(1, region), "News"));
+    CHECK(IsName(get_pty_code_name(5, region), rbds ? "Rock" : "Education"));
+    CHECK(IsName(get_pty_code_short_name(5, region),
+                 rbds ? "Rock" : "Educate"));
+    CHECK(IsName(get_pty_code_name(16, region),
+                 rbds ? "Rhythm and Blues" : "Weather"));
+    CHECK(IsName(get_pty_code_name(29, region),
+                 rbds ? "Weather" : "Documentary"));
+    CHECK(IsName(get_pty_code_name(31, region),
+                 rbds ? "Emergency" : "Alarm - Alarm !"));
+    CHECK(IsName(get_pty_code_short_name(31, region),
+                 rbds ? "ALERT!" : "Alarm !"));
+  }
+}
+
+// Every name fits the display: 16 characters, or 8 for the short names.
+void TestLengths() {
+  for (enum si470x_region_t region : kRegions) {
+    for (uint8_t code = 1; code < 32; code++) {
+      const char* name = get_pty_code_name(code, region);
+      const char* short_name = get_pty_code_short_name(code, region);
+      CHECK(name && *name && strlen(name) <= 16);
+      CHECK(short_name && *short_name && strlen(short_name) <= 8);
+    }
+  }
+}
+
+void TestBounds() {
+  for (enum si470x_region_t region : kRegions) {
+    for (uint32_t code = 32; code <= 0xFF; code++) {
+      CHECK(IsName(get_pty_code_name(code, region), "[Invalid]"));
+      CHECK(IsName(get_pty_code_short_name(code, region), "Invalid"));
+    }
+  }
+}
+
+}  // namespace
+
+int main() {
+  TestNames();
+  TestLengths();
+  TestBounds();
+  return TestResult();
+}
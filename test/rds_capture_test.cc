@@ -0,0 +1,244 @@
+// RDS captures: round trips timed and untimed captures through the writer
+// and reader, checks the record sizes and that damaged headers are rejected,
+// and times reading the groups of each.
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <initializer_list>
+#include <random>
+#include <vector>
+
+#include <rds_capture.h>
+
+#include "check.h"
+
+namespace {
+
+const char kFname[] = "rds_capture_test.rdsc";
+
+// Random groups, with block errors of 0 to 5 (which captures clamp to 3).
+std::vector<struct rds_blocks> RandomGroups(size_t count) {
+  std::mt19937 rng(25);
+  std::vector<struct rds_blocks> groups(count);
+  for (struct rds_blocks& blocks : groups) {
+    struct rds_block* block_list[] = {&blocks.a, &blocks.b, &blocks.c,
+                                      &blocks.d};
+    for (struct rds_block* block : block_list) {
+      block->val = rng();
+      block->errors = rng() % 8 < 6 ? 0 : rng() % 6;
+    }
+  }
+  return groups;
+}
+
+bool Write(const std::vector<struct rds_blocks>& groups,
+           bool timed,
+           uint32_t interval) {
+  struct rds_capture_writer* writer = create_rds_capture_writer(kFname, timed);
+  if (!writer)
+    return false;
+  const int64_t kStart = INT64_C(1767225600000);
+  bool ok = true;
+  for (size_t i = 0; i < groups.size() && ok; i++)
+    ok = write_rds_capture_group(writer, &groups[i], kStart + i * interval);
+  return close_rds_capture_writer(writer) && ok;
+}
+
+long FileSize(const char* fname) {
+  FILE* f = fopen(fname, "rb");
+  if (!f)
+    return -1;
+  fseek(f, 0, SEEK_END);
+  const long size = ftell(f);
+  fclose(f);
+  return size;
+}
+
+uint8_t Clamp(uint8_t errors) {
+  return errors < 3 ? errors : 3;
+}
+
+void CheckGroups(const struct rds_capture* capture,
+                 const std::vector<struct rds_blocks>& expected) {
+  CHECK(get_rds_capture_num_groups(capture) == expected.size());
+  std::vector<struct rds_blocks> groups(expected.size() + 1);
+  CHECK(read_rds_capture_blocks(capture, 0, groups.data(), groups.size()) ==
+        expected.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    const struct rds_blocks& a = groups[i];
+    const struct rds_blocks& b = expected[i];
+    CHECK(a.a.val == b.a.val && a.b.val == b.b.val && a.c.val == b.c.val &&
+          a.d.val == b.d.val);
+    CHECK(a.a.errors == Clamp(b.a.errors) && a.b.errors == Clamp(b.b.errors) &&
+          a.c.errors == Clamp(b.c.errors) && a.d.errors == Clamp(b.d.errors));
+  }
+  // From the middle, and past the end.
+  CHECK(read_rds_capture_blocks(capture, expected.size() - 1, groups.data(),
+                                10) == 1);
+  CHECK(read_rds_capture_blocks(capture, expected.size(), groups.data(), 1) ==
+        0);
+}
+
+void TestUntimed() {
+  const std::vector<struct rds_blocks> expected = RandomGroups(5000);
+  CHECK(Write(expected, /*timed=*/false, 0));
+  CHECK(FileSize(kFname) == static_cast<long>(sizeof(rds_capture_header) +
+                                               expected.size() * 12));
+  struct rds_capture* capture = open_rds_capture(kFname);
+  CHECK(capture != nullptr);
+  if (!capture)
+    return;
+  CheckGroups(capture, expected);
+  int64_t start;
+  uint32_t time;
+  size_t group;
+  CHECK(!get_rds_capture_start_time(capture, &start));
+  CHECK(!get_rds_capture_time(capture, 0, &time));
+  CHECK(!find_rds_capture_group(capture, 0, &group));
+  close_rds_capture(capture);
+  remove(kFname);
+}
+
+void TestTimed() {
+  const std::vector<struct rds_blocks> expected = RandomGroups(5000);
+  CHECK(Write(expected, /*timed=*/true, 88));
+  const size_t num_index =
+      (expected.size() + RDS_CAPTURE_INDEX_INTERVAL - 1) /
+      RDS_CAPTURE_INDEX_INTERVAL;
+  CHECK(FileSize(kFname) ==
+        static_cast<long>(sizeof(rds_capture_header) +
+                          expected.size() * sizeof(rds_capture_record) +
+                          num_index * sizeof(uint32_t)));
+  struct rds_capture* capture = open_rds_capture(kFname);
+  CHECK(capture != nullptr);
+  if (!capture)
+    return;
+  CheckGroups(capture, expected);
+  int64_t start;
+  CHECK(get_rds_capture_start_time(capture, &start));
+  CHECK(start == INT64_C(1767225600000));
+  for (uint32_t i = 0; i < expected.size(); i++) {
+    uint32_t time;
+    CHECK(get_rds_capture_time(capture, i, &time) && time == i * 88);
+  }
+  for (uint32_t time = 0; time < expected.size() * 88 + 500; time += 7) {
+    size_t group;
+    CHECK(find_rds_capture_group(capture, time, &group));
+    CHECK(group == std::min<size_t>((time + 87) / 88, expected.size()));
+  }
+  close_rds_capture(capture);
+  remove(kFname);
+}
+
+bool OpensAfterWriting(const std::vector<char>& data) {
+  FILE* f = fopen(kFname, "wb");
+  if (!f)
+    return false;
+  fwrite(data.data(), 1, data.size(), f);
+  fclose(f);
+  struct rds_capture* capture = open_rds_capture(kFname);
+  close_rds_capture(capture);
+  remove(kFname);
+  return capture != nullptr;
+}
+
+// Untimed captures with timed size records (as were once written) are read,
+// but other record sizes, and damaged headers, are rejected.
+void TestHeaders() {
+  const std::vector<struct rds_blocks> expected = RandomGroups(10);
+  std::vector<char> capture(sizeof(rds_capture_header) +
+                            expected.size() * sizeof(rds_capture_record));
+  struct rds_capture_header* header =
+      reinterpret_cast<struct rds_capture_header*>(capture.data());
+  header->magic = RDS_CAPTURE_MAGIC;
+  header->version = RDS_CAPTURE_VERSION;
+  header->record_size = sizeof(rds_capture_record);
+  header->index_interval = RDS_CAPTURE_INDEX_INTERVAL;
+  header->num_groups = expected.size();
+  header->index_offset = capture.size();
+  header->file_size = capture.size();
+  struct rds_capture_record* records =
+      reinterpret_cast<struct rds_capture_record*>(header + 1);
+  for (size_t i = 0; i < expected.size(); i++) {
+    records[i].group.blocks[0] = expected[i].a.val;
+    records[i].group.blocks[1] = expected[i].b.val;
+    records[i].group.blocks[2] = expected[i].c.val;
+    records[i].group.blocks[3] = expected[i].d.val;
+    records[i].group.errors = Clamp(expected[i].a.errors) |
+                              Clamp(expected[i].b.errors) << 2 |
+                              Clamp(expected[i].c.errors) << 4 |
+                              Clamp(expected[i].d.errors) << 6;
+  }
+  FILE* f = fopen(kFname, "wb");
+  CHECK(f != nullptr);
+  if (!f)
+    return;
+  fwrite(capture.data(), 1, capture.size(), f);
+  fclose(f);
+  struct rds_capture* old = open_rds_capture(kFname);
+  CHECK(old != nullptr);
+  if (old)
+    CheckGroups(old, expected);
+  close_rds_capture(old);
+  remove(kFname);
+
+  std::vector<char> bad = capture;
+  reinterpret_cast<struct rds_capture_header*>(bad.data())->record_size = 14;
+  CHECK(!OpensAfterWriting(bad));
+  bad = capture;
+  reinterpret_cast<struct rds_capture_header*>(bad.data())->magic ^= 1;
+  CHECK(!OpensAfterWriting(bad));
+  bad = capture;
+  bad.pop_back();
+  CHECK(!OpensAfterWriting(bad));
+
+  // A timed capture can't have untimed records.
+  CHECK(Write(expected, /*timed=*/true, 100));
+  f = fopen(kFname, "rb");
+  CHECK(f != nullptr);
+  if (!f)
+    return;
+  std::vector<char> timed(FileSize(kFname));
+  CHECK(fread(timed.data(), 1, timed.size(), f) == timed.size());
+  fclose(f);
+  CHECK(OpensAfterWriting(timed));
+  reinterpret_cast<struct rds_capture_header*>(timed.data())->record_size =
+      sizeof(rds_capture_group);
+  CHECK(!OpensAfterWriting(timed));
+}
+
+// Rates are in groups per second.
+void BenchmarkReads() {
+  const std::vector<struct rds_blocks> groups = RandomGroups(1 << 20);
+  std::vector<struct rds_blocks> blocks(groups.size());
+  for (bool timed : {false, true}) {
+    CHECK(Write(groups, timed, 88));
+    struct rds_capture* capture = open_rds_capture(kFname);
+    CHECK(capture != nullptr);
+    if (!capture)
+      continue;
+    const uint32_t kBatch = 4096;
+    Benchmark(timed ? "read_rds_capture_blocks (timed)"
+                    : "read_rds_capture_blocks",
+              groups.size(), [&](uint32_t i) {
+                if (i % kBatch)
+                  return 0u;
+                read_rds_capture_blocks(capture, i, &blocks[i], kBatch);
+                return static_cast<uint32_t>(blocks[i].a.val);
+              });
+    close_rds_capture(capture);
+    remove(kFname);
+  }
+}
+
+}  // namespace
+
+int main() {
+  TestUntimed();
+  TestTimed();
+  TestHeaders();
+  BenchmarkReads();
+  return TestResult();
+}
@@ -0,0 +1,220 @@
+// RDS Spy log reader: decodes generated logs (every block value in both
+// cases, missing blocks, timestamps, CRLF and non-group lines) and checks
+// that lines with a bad character are skipped. Times decoding with the
+// mapped cursor against fgets() and sscanf(), which rdsdisplay used to load
+// logs with.
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <random>
+#include <vector>
+
+#include <rds_spy_reader.h>
+
+#include "check.h"
+
+namespace {
+
+const char kFname[] = "rds_spy_reader_test.spy";
+
+bool SameBlock(const struct rds_block& a, const struct rds_block& b) {
+  return a.val == b.val && a.errors == b.errors;
+}
+
+bool SameBlocks(const struct rds_blocks& a, const struct rds_blocks& b) {
+  return SameBlock(a.a, b.a) && SameBlock(a.b, b.b) && SameBlock(a.c, b.c) &&
+         SameBlock(a.d, b.d);
+}
+
+struct rds_block Block(uint16_t val) {
+  struct rds_block block;
+  block.val = val;
+  block.errors = 0;
+  return block;
+}
+
+struct rds_block MissingBlock() {
+  struct rds_block block;
+  block.val = 0;
+  block.errors = RDS_SPY_MISSING_ERRORS;
+  return block;
+}
+
+// Decode all of |fname|, which must have the groups |expected|.
+void CheckLog(const char* fname,
+              const std::vector<struct rds_blocks>& expected) {
+  struct rds_spy_log* log = open_rds_spy_log(fname);
+  CHECK(log != nullptr);
+  if (!log)
+    return;
+  CHECK(get_rds_spy_log_max_groups(log) >= expected.size());
+  struct rds_spy_cursor cursor;
+  init_rds_spy_cursor(log, &cursor);
+  struct rds_blocks blocks;
+  size_t count = 0;
+  while (next_rds_spy_blocks(&cursor, &blocks)) {
+    if (count < expected.size())
+      CHECK(SameBlocks(blocks, expected[count]));
+    count++;
+  }
+  CHECK(count == expected.size());
+  close_rds_spy_log(log);
+}
+
+// Every 16-bit value, in upper and lower case.
+void TestAllValues() {
+  FILE* f = fopen(kFname, "w");
+  CHECK(f != nullptr);
+  if (!f)
+    return;
+  std::vector<struct rds_blocks> expected;
+  fprintf(f, "<recorder=\"RDS Spy\">\n\n");
+  for (uint32_t val = 0; val <= 0xFFFF; val++) {
+    fprintf(f, "%04X %04x ---- %04X\n", val, val, val ^ 0x5A5A);
+    struct rds_blocks blocks;
+    blocks.a = Block(val);
+    blocks.b = Block(val);
+    blocks.c = MissingBlock();
+    blocks.d = Block(val ^ 0x5A5A);
+    expected.push_back(blocks);
+  }
+  fclose(f);
+  CheckLog(kFname, expected);
+  remove(kFname);
+}
+
+// A line with any character other than a hex digit in a block isn't a group.
+void TestBadCharacters() {
+  FILE* f = fopen(kFname, "wb");
+  CHECK(f != nullptr);
+  if (!f)
+    return;
+  for (int ch = 1; ch < 256; ch++) {
+    if (isxdigit(ch) || ch == '\n')
+      continue;
+    for (int pos = 0; pos < 4; pos++) {
+      char text[5] = "1234";
+      text[pos] = ch;
+      fprintf(f, "%s 5678 9ABC DEF0\n", text);
+      fprintf(f, "1234 5678 9ABC %s\n", text);
+    }
+  }
+  fprintf(f, "1234 5678 9ABC DEF0X\n");  // Not followed by a space.
+  fprintf(f, "1234 5678 9ABC\n");        // Too short.
+  fprintf(f, "1234 5678 --- DEF0\n");
+  fprintf(f, "1234 5678 9ABC DEF0");  // The only group: unterminated.
+  fclose(f);
+  struct rds_blocks blocks;
+  blocks.a = Block(0x1234);
+  blocks.b = Block(0x5678);
+  blocks.c = Block(0x9ABC);
+  blocks.d = Block(0xDEF0);
+  CheckLog(kFname, {blocks});
+  remove(kFname);
+}
+
+// Write a log of |count| random groups, timestamped 10 ms apart.
+std::vector<struct rds_blocks> WriteRandomLog(const char* fname,
+                                              uint32_t count) {
+  std::vector<struct rds_blocks> groups;
+  FILE* f = fopen(fname, "wb");
+  if (!f)
+    return groups;
+  std::mt19937 rng(24);
+  fprintf(f, "<recorder=\"RDS Spy\">\r\n");
+  for (uint32_t i = 0; i < count; i++) {
+    struct rds_blocks blocks;
+    struct rds_block* block[] = {&blocks.a, &blocks.b, &blocks.c, &blocks.d};
+    for (int b = 0; b < 4; b++) {
+      if (rng() % 32 == 0) {
+        *block[b] = MissingBlock();
+        fprintf(f, "----");
+      } else {
+        *block[b] = Block(rng());
+        fprintf(f, "%04X", block[b]->val);
+      }
+      if (b < 3)
+        fputc(' ', f);
+    }
+    const uint32_t cs = i;  // Centiseconds.
+    fprintf(f, " @2026/01/01 %02u:%02u:%02u.%02u%s", cs / 360000 % 24,
+            cs / 6000 % 60, cs / 100 % 60, cs % 100, i % 2 ? "\r\n" : "\n");
+    groups.push_back(blocks);
+  }
+  fclose(f);
+  return groups;
+}
+
+void TestTimestamps() {
+  const std::vector<struct rds_blocks> expected =
+      WriteRandomLog(kFname, 1000);
+  CheckLog(kFname, expected);
+  struct rds_spy_log* log = open_rds_spy_log(kFname);
+  CHECK(log != nullptr);
+  if (!log)
+    return;
+  struct rds_spy_cursor cursor;
+  init_rds_spy_cursor(log, &cursor);
+  int64_t time;
+  CHECK(!get_rds_spy_time(&cursor, &time));
+  struct rds_blocks blocks;
+  const int64_t kStart = INT64_C(1767225600000);  // 2026-01-01 in ms.
+  for (int64_t i = 0; next_rds_spy_blocks(&cursor, &blocks); i++) {
+    CHECK(get_rds_spy_time(&cursor, &time));
+    CHECK(time == kStart + i * 10);
+  }
+  close_rds_spy_log(log);
+  remove(kFname);
+}
+
+// Rates are in groups per second. sscanf() can't parse missing blocks, so
+// (like the old loader) it skips those groups.
+void BenchmarkReaders() {
+  const uint32_t kGroups = 500000;
+  WriteRandomLog(kFname, kGroups);
+
+  FILE* f = fopen(kFname, "r");
+  CHECK(f != nullptr);
+  if (f) {
+    Benchmark("fgets + sscanf", kGroups, [f](uint32_t) {
+      char line[256];
+      unsigned a, b, c, d;
+      while (fgets(line, sizeof(line), f)) {
+        if (line[0] != '<' &&
+            sscanf(line, "%x %x %x %x", &a, &b, &c, &d) == 4) {
+          return a ^ b ^ c ^ d;
+        }
+      }
+      return 0u;
+    });
+    fclose(f);
+  }
+
+  struct rds_spy_log* log = open_rds_spy_log(kFname);
+  CHECK(log != nullptr);
+  if (log) {
+    struct rds_spy_cursor cursor;
+    init_rds_spy_cursor(log, &cursor);
+    Benchmark("next_rds_spy_blocks", kGroups, [&cursor](uint32_t) {
+      struct rds_blocks blocks;
+      if (!next_rds_spy_blocks(&cursor, &blocks))
+        return 0u;
+      return static_cast<uint32_t>(blocks.a.val ^ blocks.b.val ^
+                                   blocks.c.val ^ blocks.d.val);
+    });
+    close_rds_spy_log(log);
+  }
+  remove(kFname);
+}
+
+}  // namespace
+
+int main() {
+  TestAllValues();
+  TestBadCharacters();
+  TestTimestamps();
+  BenchmarkReaders();
+  return TestResult();
+}
@@ -0,0 +1,373 @@
+// RT+ tags and items: the tag store (order, eviction, text spans and
+// clearing), tag change tracking, item boundaries from the toggle and running
+// bits, the ring of completed items and reading it with
+// get_next_rtplus_item(). Times building the tag lines on every frame against
+// only when consume_oda_tag_changes() reports a change.
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include <oda_decode.h>
+#include <rds_util.h>
+
+#include "check.h"
+
+namespace {
+
+const uint8_t kItemTitle = 1;
+const uint8_t kItemArtist = 4;
+
+struct Decoder {
+  Decoder() : oda(create_oda_data()) { memset(&rds, 0, sizeof(rds)); }
+  ~Decoder() { delete_oda_data(oda); }
+
+  // Set the RadioText to "<title> - <artist>" (a new message) and send an
+  // RT+ group tagging both.
+  void Play(const char* title, const char* artist, bool toggle) {
+    rds.rt.decode_rt = rds.rt.decode_rt == RT_A ? RT_B : RT_A;
+    struct rds_rt* rt = rds.rt.decode_rt == RT_A ? &rds.rt.a : &rds.rt.b;
+    memset(rt->display, ' ', sizeof(rt->display));
+    char text[sizeof(rt->display) + 1];
+    snprintf(text, sizeof(text), "%s - %s", title, artist);
+    memcpy(rt->display, text, strlen(text));
+    const uint8_t artist_start = strlen(title) + 3;
+    Group(toggle, true, kItemTitle, 0, strlen(title) - 1, kItemArtist,
+          artist_start, strlen(artist) - 1);
+  }
+
+  // Start a new RadioText message (flip A/B) of |text|, without a group.
+  void SetText(const char* text) {
+    rds.rt.decode_rt = rds.rt.decode_rt == RT_A ? RT_B : RT_A;
+    struct rds_rt* rt = rds.rt.decode_rt == RT_A ? &rds.rt.a : &rds.rt.b;
+    memset(rt->display, ' ', sizeof(rt->display));
+    memcpy(rt->display, text, strlen(text));
+  }
+
+  // An RT+ group tagging one span, with the item not running.
+  void Tag(uint8_t content_type, uint8_t start, uint8_t len) {
+    Group(false, false, content_type, start, len - 1, 0, 0, 0);
+  }
+
+  // An RT+ group with the given bits and tags.
+  void Group(bool toggle, bool running, uint8_t type1, uint8_t start1,
+             uint8_t len1, uint8_t type2, uint8_t start2, uint8_t len2) {
+    struct rds_blocks blocks;
+    memset(&blocks, 0, sizeof(blocks));
+    blocks.b.val = toggle << 4 | running << 3 | type1 >> 3;
+    blocks.c.val = (type1 & 7) << 13 | start1 << 7 | len1 << 1 | type2 >> 5;
+    blocks.d.val = (type2 & 0x1F) << 11 | start2 << 5 | len2;
+    const struct rds_group_type gt = {11, 'A'};
+    decode_oda_blocks(oda, AID_RT_PLUS, &rds, &blocks, gt);
+  }
+
+  struct rds_oda_data* oda;
+  struct rds_data rds;
+};
+
+std::vector<uint8_t> ContentTypes(const struct rds_oda_tags& tags) {
+  std::vector<uint8_t> types;
+  for (uint8_t i = 0; i < tags.count; i++)
+    types.push_back(tags.tag[i].content_type);
+  return types;
+}
+
+std::string TagText(const Decoder& dec, uint8_t content_type) {
+  const struct rds_oda_tag* tag = find_oda_tag(&dec.oda->rtplus, content_type);
+  if (!tag)
+    return "<none>";
+  size_t len;
+  const char* text = get_oda_tag_text(tag, &dec.rds, &len);
+  return std::string(text, len);
+}
+
+// Tags are kept sorted by content type, whatever order they arrive in.
+void TestTagOrder() {
+  Decoder dec;
+  dec.SetText("One two three");
+  dec.Tag(30, 8, 5);
+  dec.Tag(5, 0, 3);
+  dec.Tag(17, 4, 3);
+  const struct rds_oda_tags& tags = dec.oda->rtplus;
+  CHECK(ContentTypes(tags) == std::vector<uint8_t>({5, 17, 30}));
+  CHECK(tags.active == (UINT64_C(1) << 5 | UINT64_C(1) << 17 |
+                        UINT64_C(1) << 30));
+  CHECK(TagText(dec, 5) == "One" && TagText(dec, 17) == "two" &&
+        TagText(dec, 30) == "three");
+  CHECK(TagText(dec, 6) == "<none>");
+  CHECK(find_oda_tag(&tags, 64) == nullptr);
+
+  // Replacing a tag keeps its place.
+  dec.Tag(17, 4, 8);
+  CHECK(ContentTypes(tags) == std::vector<uint8_t>({5, 17, 30}));
+  CHECK(TagText(dec, 17) == "two thre");
+}
+
+// The text is a span of the RadioText the tag was received with, clamped to
+// its end, and stays with that (A or B) buffer when the next message starts.
+void TestTagText() {
+  Decoder dec;
+  dec.SetText("Hello world");
+  dec.Tag(kItemTitle, 0, 5);
+  dec.Tag(kItemArtist, 60, 10);
+  CHECK(TagText(dec, kItemTitle) == "Hello");
+  CHECK(find_oda_tag(&dec.oda->rtplus, kItemArtist)->length == 4);
+
+  dec.SetText("Goodbye");
+  CHECK(TagText(dec, kItemTitle) == "Hello");
+  dec.Tag(kItemTitle, 0, 7);
+  CHECK(TagText(dec, kItemTitle) == "Goodbye");
+}
+
+// With every slot in use, a new content type evicts the tag received with
+// the oldest RadioText.
+void TestTagEviction() {
+  Decoder dec;
+  const struct rds_oda_tags& tags = dec.oda->rtplus;
+  dec.SetText("Old");
+  for (uint8_t type = 1; type <= ODA_MAX_TAGS / 2; type++)
+    dec.Tag(type, 0, 3);
+  dec.SetText("New");
+  for (uint8_t type = ODA_MAX_TAGS / 2 + 1; type <= ODA_MAX_TAGS; type++)
+    dec.Tag(type, 0, 3);
+  // Resend all but one of the old tags with the new RadioText.
+  const uint8_t kStale = 2;
+  for (uint8_t type = 1; type <= ODA_MAX_TAGS / 2; type++) {
+    if (type != kStale)
+      dec.Tag(type, 0, 3);
+  }
+  CHECK(tags.count == ODA_MAX_TAGS);
+  consume_oda_tag_changes(&dec.oda->rtplus);
+
+  dec.Tag(40, 0, 3);
+  CHECK(tags.count == ODA_MAX_TAGS);
+  CHECK(find_oda_tag(&tags, kStale) == nullptr);
+  CHECK(TagText(dec, 40) == "New");
+  CHECK(consume_oda_tag_changes(&dec.oda->rtplus) ==
+        (UINT64_C(1) << kStale | UINT64_C(1) << 40));
+  std::vector<uint8_t> expected;
+  for (uint8_t type = 1; type <= ODA_MAX_TAGS; type++) {
+    if (type != kStale)
+      expected.push_back(type);
+  }
+  expected.push_back(40);
+  CHECK(ContentTypes(tags) == expected);
+}
+
+// Clearing only resets the bitmasks and count, whatever the number of tags:
+// the tag slots themselves aren't touched.
+void TestClearTags() {
+  Decoder dec;
+  dec.SetText("Some text");
+  for (uint8_t type = 1; type <= 3; type++)
+    dec.Tag(type, 0, 4);
+  consume_oda_tag_changes(&dec.oda->rtplus);
+  struct rds_oda_tag slots[ODA_MAX_TAGS];
+  memcpy(slots, dec.oda->rtplus.tag, sizeof(slots));
+
+  clear_oda_data(dec.oda);
+  const struct rds_oda_tags& tags = dec.oda->rtplus;
+  CHECK(tags.count == 0 && tags.active == 0);
+  CHECK(consume_oda_tag_changes(&dec.oda->rtplus) == 0xE);
+  CHECK(!memcmp(slots, tags.tag, sizeof(slots)));
+  CHECK(find_oda_tag(&tags, 1) == nullptr);
+
+  // And the store is usable again.
+  dec.Tag(2, 5, 4);
+  CHECK(ContentTypes(tags) == std::vector<uint8_t>({2}));
+  CHECK(TagText(dec, 2) == "text");
+}
+
+void TestTagChanges() {
+  Decoder dec;
+  dec.Play("Song", "Artist", false);
+  const uint64_t kBoth = 1u << kItemTitle | 1u << kItemArtist;
+  CHECK(consume_oda_tag_changes(&dec.oda->rtplus) == kBoth);
+  CHECK(consume_oda_tag_changes(&dec.oda->rtplus) == 0);
+
+  // Stations repeat their tags constantly.
+  dec.Group(false, true, kItemTitle, 0, 3, kItemArtist, 7, 5);
+  CHECK(consume_oda_tag_changes(&dec.oda->rtplus) == 0);
+
+  // A tag moved to a new span.
+  dec.Group(false, true, kItemTitle, 1, 2, kItemArtist, 7, 5);
+  CHECK(consume_oda_tag_changes(&dec.oda->rtplus) == 1u << kItemTitle);
+
+  // The same span of a new RadioText.
+  dec.Play("Song", "Artist", false);
+  CHECK(consume_oda_tag_changes(&dec.oda->rtplus) == kBoth);
+
+  // Removal: a zero length tag at a space.
+  dec.Group(false, true, kItemTitle, 4, 0, 0, 0, 0);
+  CHECK(consume_oda_tag_changes(&dec.oda->rtplus) == 1u << kItemTitle);
+  CHECK(find_oda_tag(&dec.oda->rtplus, kItemTitle) == nullptr);
+
+  clear_oda_data(dec.oda);
+  CHECK(consume_oda_tag_changes(&dec.oda->rtplus) == 1u << kItemArtist);
+}
+
+void TestItems() {
+  Decoder dec;
+  set_oda_time(dec.oda, 100);
+  dec.Play("Song 1", "Artist 1", false);
+  uint32_t cursor = 0;
+  CHECK(get_next_rtplus_item(dec.oda, &cursor) == nullptr);
+  CHECK(!strcmp(dec.oda->rtplus_history.current.title, "Song 1"));
+
+  set_oda_time(dec.oda, 280);
+  dec.Play("Song 2", "Artist 2", true);
+  const struct rtplus_item* item = get_next_rtplus_item(dec.oda, &cursor);
+  CHECK(item != nullptr);
+  if (item) {
+    CHECK(!strcmp(item->title, "Song 1"));
+    CHECK(!strcmp(item->artist, "Artist 1"));
+    CHECK(item->started == 100 && item->ended == 280);
+  }
+  CHECK(get_next_rtplus_item(dec.oda, &cursor) == nullptr);
+
+  // Clearing the running bit ends the item too.
+  set_oda_time(dec.oda, 400);
+  dec.Group(true, false, 0, 0, 0, 0, 0, 0);
+  item = get_next_rtplus_item(dec.oda, &cursor);
+  CHECK(item && !strcmp(item->title, "Song 2") && item->ended == 400);
+}
+
+// Only the last RTPLUS_HISTORY_SIZE items are kept, and a reader which falls
+// behind skips to the oldest.
+void TestRing() {
+  Decoder dec;
+  const uint32_t kItems = RTPLUS_HISTORY_SIZE * 2 + 1;
+  char title[16];
+  for (uint32_t i = 0; i <= kItems; i++) {
+    snprintf(title, sizeof(title), "Song %u", i);
+    dec.Play(title, "Artist", i % 2);
+  }
+  CHECK(dec.oda->rtplus_history.count == kItems);
+
+  uint32_t cursor = 0;
+  uint32_t expected = kItems - RTPLUS_HISTORY_SIZE;
+  while (const struct rtplus_item* item =
+             get_next_rtplus_item(dec.oda, &cursor)) {
+    snprintf(title, sizeof(title), "Song %u", expected++);
+    CHECK(!strcmp(item->title, title));
+  }
+  CHECK(expected == kItems);
+  CHECK(cursor == kItems);
+
+  // A cursor past the end (e.g. from before a clear) restarts at the oldest.
+  cursor = kItems + 10;
+  CHECK(get_next_rtplus_item(dec.oda, &cursor) != nullptr);
+  CHECK(cursor == kItems - RTPLUS_HISTORY_SIZE + 1);
+}
+
+// Items with no title or artist tag aren't kept, and a missing tag doesn't
+// stop the other being copied.
+void TestMissingTags() {
+  Decoder dec;
+  dec.Group(false, true, 0, 0, 0, 0, 0, 0);
+  dec.Group(true, true, 0, 0, 0, 0, 0, 0);
+  CHECK(dec.oda->rtplus_history.count == 0);
+
+  memcpy(dec.rds.rt.a.display, "Only a title", 12);
+  dec.Group(true, true, kItemTitle, 0, 11, 0, 0, 0);
+  dec.Group(false, true, 0, 0, 0, 0, 0, 0);
+  uint32_t cursor = 0;
+  const struct rtplus_item* item = get_next_rtplus_item(dec.oda, &cursor);
+  CHECK(item && !strcmp(item->title, "Only a title") && !item->artist[0]);
+}
+
+// A new item (toggle) whose first group only tags the title: the old item's
+// artist tag indexed the old RadioText, so the new item has no artist until
+// its own artist tag arrives.
+void TestToggleDropsItemTags() {
+  Decoder dec;
+  dec.Play("Old song", "Old artist", false);
+  dec.Group(false, true, 31, 0, 2, 0, 0, 0);  // A non-ITEM tag (INFO.URL).
+  CHECK(find_oda_tag(&dec.oda->rtplus, kItemArtist) != nullptr);
+
+  dec.SetText("New song by somebody else entirely");
+  dec.Group(true, true, kItemTitle, 0, 7, 0, 0, 0);
+  CHECK(find_oda_tag(&dec.oda->rtplus, kItemArtist) == nullptr);
+  CHECK(find_oda_tag(&dec.oda->rtplus, 31) != nullptr);
+  CHECK(!strcmp(dec.oda->rtplus_history.current.title, "New song"));
+  CHECK(!dec.oda->rtplus_history.current.artist[0]);
+
+  uint32_t cursor = 0;
+  const struct rtplus_item* item = get_next_rtplus_item(dec.oda, &cursor);
+  CHECK(item && !strcmp(item->title, "Old song") &&
+        !strcmp(item->artist, "Old artist"));
+
+  // The artist arrives in a later group.
+  dec.Group(true, true, kItemTitle, 0, 7, kItemArtist, 12, 8);
+  CHECK(!strcmp(dec.oda->rtplus_history.current.title, "New song"));
+  CHECK(!strcmp(dec.oda->rtplus_history.current.artist, "somebody"));
+
+  // And the new item is stored with only its own text.
+  dec.SetText("Third song");
+  dec.Group(false, true, kItemTitle, 0, 9, 0, 0, 0);
+  item = get_next_rtplus_item(dec.oda, &cursor);
+  CHECK(item && !strcmp(item->title, "New song") &&
+        !strcmp(item->artist, "somebody"));
+  CHECK(!dec.oda->rtplus_history.current.artist[0]);
+}
+
+// As rdsdisplay formats its RT+ lines.
+void BuildTagLines(const struct rds_oda_tags& tags,
+                   const struct rds_data& rds,
+                   std::vector<std::string>* lines) {
+  lines->clear();
+  for (uint64_t active = tags.active; active; active &= active - 1) {
+    const uint8_t content_type = __builtin_ctzll(active);
+    size_t len;
+    const char* text =
+        get_oda_tag_text(find_oda_tag(&tags, content_type), &rds, &len);
+    while (len && text[len - 1] == ' ')
+      len--;
+    lines->push_back(std::string(get_rdsplus_code_name(content_type)) +
+                     ": \"" + std::string(text, len) + "\"");
+  }
+}
+
+// A station repeating its tags, with a new item every 64 groups, and a
+// frame drawn per group.
+void BenchmarkTagLines() {
+  Decoder dec;
+  std::vector<std::string> lines;
+  Benchmark("tag lines every frame", 2000000, [&](uint32_t i) {
+    if (i % 64 == 0)
+      dec.Play(i % 128 ? "Song 1" : "Song 2", "Artist", false);
+    else
+      dec.Group(false, true, kItemTitle, 0, 5, kItemArtist, 9, 5);
+    BuildTagLines(dec.oda->rtplus, dec.rds, &lines);
+    return static_cast<uint32_t>(lines.size());
+  });
+  Benchmark("tag lines on change", 2000000, [&](uint32_t i) {
+    if (i % 64 == 0)
+      dec.Play(i % 128 ? "Song 1" : "Song 2", "Artist", false);
+    else
+      dec.Group(false, true, kItemTitle, 0, 5, kItemArtist, 9, 5);
+    if (consume_oda_tag_changes(&dec.oda->rtplus))
+      BuildTagLines(dec.oda->rtplus, dec.rds, &lines);
+    return static_cast<uint32_t>(lines.size());
+  });
+}
+
+}  // namespace
+
+int main() {
+  TestTagOrder();
+  TestTagText();
+  TestTagEviction();
+  TestClearTags();
+  TestTagChanges();
+  TestItems();
+  TestRing();
+  TestMissingTags();
+  TestToggleDropsItemTags();
+  BenchmarkTagLines();
+  printf("sizeof(struct rtplus_history): %zu\n",
+         sizeof(struct rtplus_history));
+  return TestResult();
+}
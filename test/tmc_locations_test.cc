@@ -0,0 +1,144 @@
+// TMC location index: reads back an index built by tmc_location_compiler
+// from test/data/tmc_lcl_*.txt, checks that damaged files are rejected, and
+// times location lookups.
+//
+// usage: tmc_locations_test <index file>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include <tmc_locations.h>
+
+#include "check.h"
+
+namespace {
+
+void TestRoad(const struct tmc_location_index* index) {
+  struct tmc_location loc;
+  CHECK(get_tmc_location(index, 1, 1, &loc));
+  CHECK(loc.loc_class == 'A' && loc.type == 1 && loc.subtype == 5);
+  CHECK(!strcmp(loc.first_name, "Testland"));
+  CHECK(!strcmp(loc.road_number, "") && !strcmp(loc.second_name, ""));
+
+  CHECK(get_tmc_location(index, 1, 10, &loc));
+  CHECK(loc.loc_class == 'L' && loc.area_ref == 1);
+  CHECK(!strcmp(loc.road_name, "Test Motorway"));
+  CHECK(!strcmp(loc.second_name, "South End"));
+
+  for (uint16_t lcd = 100; lcd < 140; lcd++) {
+    CHECK(get_tmc_location(index, 1, lcd, &loc));
+    CHECK(loc.lcd == lcd);
+    CHECK(loc.loc_class == 'P' && loc.type == 1 && loc.subtype == 3);
+    CHECK(loc.area_ref == 1 && loc.linear_ref == 10);
+    CHECK(loc.neg_offset == (lcd > 100 ? lcd - 1 : 0));
+    CHECK(loc.pos_offset == (lcd < 139 ? lcd + 1 : 0));
+    CHECK(!strcmp(loc.road_number, "A1"));
+    CHECK(loc.first_name == "Junction " + std::to_string(lcd - 99));
+  }
+}
+
+void TestLTEF(const struct tmc_location_index* index) {
+  struct tmc_location loc;
+  CHECK(get_tmc_location(index, 2, 5000, &loc));
+  CHECK(loc.loc_class == 'P' && loc.type == 1 && loc.subtype == 11);
+  CHECK(!strcmp(loc.first_name, "Border"));
+  CHECK(loc.pos_offset == 5001 && loc.neg_offset == 0);
+  CHECK(get_tmc_location(index, 2, 5001, &loc));
+  CHECK(!strcmp(loc.first_name, "Border South"));
+  CHECK(!strcmp(loc.road_number, "A1"));
+}
+
+void TestMissing(const struct tmc_location_index* index) {
+  struct tmc_location loc;
+  CHECK(!get_tmc_location(index, 1, 0, &loc));
+  CHECK(!get_tmc_location(index, 1, 50, &loc));    // A gap in the table.
+  CHECK(!get_tmc_location(index, 1, 140, &loc));   // Past the last code.
+  CHECK(!get_tmc_location(index, 2, 100, &loc));   // Another table's code.
+  CHECK(!get_tmc_location(index, 3, 100, &loc));   // No such table.
+  CHECK(!get_tmc_location(index, TMC_NUM_LTN, 100, &loc));
+  CHECK(!get_tmc_location(nullptr, 1, 100, &loc));
+}
+
+bool ReadFile(const char* fname, std::vector<char>* data) {
+  FILE* f = fopen(fname, "rb");
+  if (!f)
+    return false;
+  char buff[4096];
+  size_t len;
+  while ((len = fread(buff, 1, sizeof(buff), f)) > 0)
+    data->insert(data->end(), buff, buff + len);
+  fclose(f);
+  return true;
+}
+
+bool OpensAfterWriting(const std::vector<char>& data) {
+  const char kFname[] = "tmc_locations_test.tmp";
+  FILE* f = fopen(kFname, "wb");
+  if (!f)
+    return false;
+  fwrite(data.data(), 1, data.size(), f);
+  fclose(f);
+  struct tmc_location_index* index = open_tmc_location_index(kFname);
+  close_tmc_location_index(index);
+  remove(kFname);
+  return index != nullptr;
+}
+
+// Truncated or otherwise damaged files must be rejected by
+// open_tmc_location_index() rather than read out of bounds.
+void TestDamaged(const char* fname) {
+  std::vector<char> data;
+  CHECK(ReadFile(fname, &data));
+  CHECK(OpensAfterWriting(data));
+  CHECK(!OpensAfterWriting(std::vector<char>()));
+
+  std::vector<char> bad(data.begin(), data.end() - 1);
+  CHECK(!OpensAfterWriting(bad));
+  bad = data;
+  bad.push_back('\0');
+  CHECK(!OpensAfterWriting(bad));
+  bad = data;
+  bad[0] ^= 1;  // Magic.
+  CHECK(!OpensAfterWriting(bad));
+  bad = data;
+  bad.back() = 'x';  // Unterminated string data.
+  CHECK(!OpensAfterWriting(bad));
+  bad = data;
+  struct tmc_index_table* table = reinterpret_cast<struct tmc_index_table*>(
+      bad.data() + sizeof(struct tmc_index_header));
+  table->num_records = 0x10000000;
+  CHECK(!OpensAfterWriting(bad));
+
+  CHECK(!open_tmc_location_index("no/such/file"));
+}
+
+void BenchmarkLookups(const struct tmc_location_index* index) {
+  Benchmark("get_tmc_location", 20000000, [index](uint32_t i) {
+    struct tmc_location loc;
+    return get_tmc_location(index, 1, 100 + i % 40, &loc) ? loc.pos_offset
+                                                          : 0u;
+  });
+}
+
+}  // namespace
+
+int main(int argc, const char** argv) {
+  if (argc != 2) {
+    fprintf(stderr, "usage: %s <index file>\n", argv[0]);
+    return 2;
+  }
+  struct tmc_location_index* index = open_tmc_location_index(argv[1]);
+  CHECK(index != nullptr);
+  if (!index)
+    return TestResult();
+  TestRoad(index);
+  TestLTEF(index);
+  TestMissing(index);
+  TestDamaged(argv[1]);
+  BenchmarkLookups(index);
+  close_tmc_location_index(index);
+  return TestResult();
+}
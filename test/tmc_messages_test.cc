@@ -0,0 +1,399 @@
+// RDS-TMC messages: single and multi-group (8A) decoding, free format
+// labels, the message pool, expiry, and the location index of affected
+// locations (using the index built from test/data/tmc_lcl_*.txt). Times
+// group decoding and location lookups.
+//
+// usage: tmc_messages_test <location index file>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <initializer_list>
+
+#include <oda_decode.h>
+#include <tmc_events.h>
+#include <tmc_locations.h>
+
+#include "check.h"
+
+namespace {
+
+struct Decoder {
+  Decoder() : oda(create_oda_data()) {
+    memset(&rds, 0, sizeof(rds));
+    set_oda_time(oda, 1000);
+  }
+  ~Decoder() { delete_oda_data(oda); }
+
+  void Group(uint16_t b, uint16_t c, uint16_t d) {
+    struct rds_blocks blocks;
+    memset(&blocks, 0, sizeof(blocks));
+    blocks.b.val = b;
+    blocks.c.val = c;
+    blocks.d.val = d;
+    const struct rds_group_type gt = {8, 'A'};
+    decode_oda_blocks(oda, AID_TMC, &rds, &blocks, gt);
+  }
+
+  void Single(uint8_t dp, uint16_t event, uint16_t location,
+              uint8_t extent = 0, bool pos_dir = false) {
+    Group(0x0008 | dp, (pos_dir ? 0x4000 : 0) | extent << 11 | event,
+          location);
+  }
+
+  // Broadcast Location Table Number |ltn| (a 3A system message).
+  void SetLTN(uint8_t ltn) {
+    struct rds_blocks blocks;
+    memset(&blocks, 0, sizeof(blocks));
+    blocks.c.val = ltn << 6;
+    const struct rds_group_type gt = {3, 'A'};
+    decode_oda_blocks(oda, AID_TMC, &rds, &blocks, gt);
+  }
+
+  uint16_t count() const { return oda->tmc.message_cnt; }
+  const struct tmc_message& msg(uint16_t i) const {
+    return oda->tmc.messages[i];
+  }
+
+  struct rds_oda_data* oda;
+  struct rds_data rds;
+};
+
+// Builds the free format bits of a multi-group message, 28 per group.
+class FreeFormat {
+ public:
+  FreeFormat() { memset(bits_, 0, sizeof(bits_)); }
+
+  FreeFormat& Add(uint32_t val, uint8_t num_bits) {
+    while (num_bits--) {
+      if (val & (1u << num_bits))
+        bits_[len_ / 8] |= 0x80 >> (len_ % 8);
+      len_++;
+    }
+    return *this;
+  }
+
+  // Label |label| with its value.
+  FreeFormat& Label(uint8_t label, uint32_t val) {
+    static const uint8_t kSizes[16] = {3, 3,  5,  5,  5,  8,  8, 8,
+                                       8, 11, 16, 16, 16, 16, 0, 0};
+    return Add(label, 4).Add(val, kSizes[label]);
+  }
+
+  uint32_t Group(uint8_t i) const {
+    uint32_t val = 0;
+    for (uint8_t pos = i * 28; pos < (i + 1) * 28; pos++)
+      val = val << 1 | ((bits_[pos / 8] >> (7 - pos % 8)) & 1);
+    return val;
+  }
+
+  uint8_t num_groups() const { return (len_ + 27) / 28; }
+
+ private:
+  uint8_t bits_[16];
+  uint8_t len_ = 0;
+};
+
+// Send a multi-group message on continuity index |ci|.
+void SendMulti(Decoder* dec, uint8_t ci, uint16_t event, uint16_t location,
+               const FreeFormat& ff, int skip_group = -1) {
+  dec->Group(ci, 0x8000 | event, location);  // First group.
+  const uint8_t groups = ff.num_groups();
+  for (uint8_t i = 0; i < groups; i++) {
+    if (i == skip_group)
+      continue;
+    const uint32_t bits = ff.Group(i);
+    const uint16_t gsi = groups - 1 - i;
+    dec->Group(ci, (i == 0 ? 0x4000 : 0) | gsi << 12 | bits >> 16,
+               bits & 0xFFFF);
+  }
+}
+
+void TestSingleGroup() {
+  Decoder dec;
+  dec.Single(1, 101, 12345, 2, true);
+  CHECK(dec.count() == 1);
+  CHECK(dec.msg(0).event == 101 && dec.msg(0).location == 12345);
+  CHECK(dec.msg(0).extent == 2 && dec.msg(0).pos_dir);
+  CHECK(!dec.msg(0).multi_group);
+  CHECK(dec.msg(0).received == 1000);
+  CHECK(dec.msg(0).expires == 1000 + 15 * 60);
+
+  // A repeat is an update of the same message.
+  set_oda_time(dec.oda, 1010);
+  dec.Single(3, 101, 12345, 2, true);
+  CHECK(dec.count() == 1);
+  CHECK(dec.msg(0).received == 1000 && dec.msg(0).updated == 1010);
+  CHECK(dec.msg(0).expires == 1010 + 60 * 60);
+
+  // Another direction is another message.
+  dec.Single(1, 101, 12345, 2, false);
+  CHECK(dec.count() == 2);
+
+  // Tuning information isn't a message.
+  dec.Group(0x0010, 0, 0);
+  CHECK(dec.count() == 2);
+}
+
+// A message without a duration takes its event's default.
+void TestDefaultDuration() {
+  struct tmc_event_info info;
+  CHECK(get_tmc_event_info(401, &info));
+  CHECK(info.longer_lasting && info.default_duration == 3);
+
+  Decoder dec;
+  dec.Single(0, 401, 1000);
+  dec.Single(0, 101, 2000);
+  CHECK(dec.count() == 2);
+  CHECK(dec.msg(0).duration == 3 && dec.msg(0).expires == 1000 + 60 * 60);
+  CHECK(dec.msg(1).duration == 0 && dec.msg(1).expires == 1000 + 15 * 60);
+
+  FreeFormat ff;
+  ff.Label(4, 7);
+  SendMulti(&dec, 1, 701, 3000, ff);
+  CHECK(dec.count() == 3 && dec.msg(2).duration == 3);
+}
+
+void TestMultiGroup() {
+  Decoder dec;
+  FreeFormat ff;
+  ff.Label(0, 5).Label(4, 7).Label(1, 5).Label(1, 6);
+  SendMulti(&dec, 2, 401, 20000, ff);
+  CHECK(dec.count() == 1);
+  const struct tmc_message& msg = dec.msg(0);
+  CHECK(msg.multi_group);
+  CHECK(msg.event == 401 && msg.location == 20000);
+  CHECK(msg.duration == 5);
+  CHECK(msg.has_quantifier && msg.quantifier == 7);
+  CHECK(msg.diversion);
+  CHECK(msg.extent == 8);
+  CHECK(msg.expires == 1000 + 3 * 60 * 60);
+}
+
+void TestLongMultiGroup() {
+  Decoder dec;
+  FreeFormat ff;
+  ff.Label(10, 0x1234).Label(10, 0x5678).Label(10, 0x9ABC).Label(0, 2);
+  CHECK(ff.num_groups() == 3);
+  SendMulti(&dec, 3, 401, 20000, ff);
+  CHECK(dec.count() == 1);
+  CHECK(dec.msg(0).duration == 2);
+  CHECK(dec.msg(0).free_format_bits == 3 * 28);
+}
+
+void TestLostGroup() {
+  Decoder dec;
+  FreeFormat ff;
+  ff.Label(10, 1).Label(10, 2).Label(10, 3).Label(0, 2);
+  SendMulti(&dec, 1, 401, 20000, ff, 1);
+  CHECK(dec.count() == 0);
+
+  // Repeated groups are ignored.
+  dec.Group(1, 0x8000 | 401, 20000);
+  dec.Group(1, 0x8000 | 401, 20000);
+  dec.Group(1, 0x4000 | 2 << 12 | ff.Group(0) >> 16, ff.Group(0) & 0xFFFF);
+  dec.Group(1, 0x4000 | 2 << 12 | ff.Group(0) >> 16, ff.Group(0) & 0xFFFF);
+  CHECK(dec.count() == 0);
+
+  // Groups on other continuity indexes don't interfere.
+  FreeFormat other;
+  other.Label(0, 1);
+  SendMulti(&dec, 4, 402, 30000, other);
+  CHECK(dec.count() == 1);
+}
+
+void TestPool() {
+  Decoder dec;
+  for (uint16_t i = 0; i < TMC_MAX_MESSAGES; i++)
+    dec.Single(i == 7 ? 1 : 7, 101, 1000 + i);
+  CHECK(dec.count() == TMC_MAX_MESSAGES);
+
+  // The message expiring soonest is evicted when the pool is full.
+  dec.Single(7, 101, 5000);
+  CHECK(dec.count() == TMC_MAX_MESSAGES);
+  bool found_evicted = false;
+  bool found_new = false;
+  for (uint16_t i = 0; i < dec.count(); i++) {
+    found_evicted |= dec.msg(i).location == 1007;
+    found_new |= dec.msg(i).location == 5000;
+  }
+  CHECK(!found_evicted && found_new);
+
+  const struct tmc_message* found[2];
+  CHECK(find_tmc_messages(dec.oda, 5000, found, 2) == 1);
+  CHECK(found[0]->location == 5000);
+  CHECK(find_tmc_messages(dec.oda, 1007, found, 2) == 0);
+
+  // Expiry.
+  set_oda_time(dec.oda, 1000 + 24 * 60 * 60);
+  CHECK(dec.count() == 0);
+  CHECK(find_tmc_messages(dec.oda, 5000, found, 2) == 0);
+}
+
+// The number of active messages affecting |location|, found the slow way.
+size_t CountMessagesAt(const struct tmc_location_index* index,
+                       const Decoder& dec,
+                       uint16_t location) {
+  size_t count = 0;
+  for (uint16_t i = 0; i < dec.count(); i++) {
+    const struct tmc_message& msg = dec.msg(i);
+    uint16_t lcd = msg.location;
+    for (uint8_t n = 0; n <= msg.extent; n++) {
+      if (lcd == location) {
+        count++;
+        break;
+      }
+      struct tmc_location loc;
+      if (!get_tmc_location(index, 1, lcd, &loc))
+        break;
+      lcd = msg.pos_dir ? loc.neg_offset : loc.pos_offset;
+      if (!lcd)
+        break;
+    }
+  }
+  return count;
+}
+
+void CheckLocationIndex(const struct tmc_location_index* index,
+                        const Decoder& dec) {
+  const struct tmc_message* found[TMC_MAX_MESSAGES];
+  for (uint16_t location = 95; location < 145; location++) {
+    const size_t count =
+        find_tmc_messages(dec.oda, location, found, TMC_MAX_MESSAGES);
+    CHECK(count == CountMessagesAt(index, dec, location));
+    for (size_t i = 0; i < count && i < TMC_MAX_MESSAGES; i++)
+      CHECK(found[i] >= &dec.msg(0) && found[i] < &dec.msg(dec.count()));
+  }
+  CHECK(dec.oda->tmc.location_ref_cnt <= TMC_MAX_LOCATION_REFS);
+}
+
+void TestExtents(const struct tmc_location_index* index) {
+  Decoder dec;
+  set_tmc_location_index(dec.oda, index);
+  dec.Single(1, 101, 110, 5);
+  const struct tmc_message* found[4];
+  // Without the station's LTN only the primary location is known.
+  CHECK(find_tmc_messages(dec.oda, 110, found, 4) == 1);
+  CHECK(find_tmc_messages(dec.oda, 113, found, 4) == 0);
+
+  dec.SetLTN(1);
+  CHECK(find_tmc_messages(dec.oda, 110, found, 4) == 1);
+  CHECK(find_tmc_messages(dec.oda, 115, found, 4) == 1);
+  CHECK(find_tmc_messages(dec.oda, 116, found, 4) == 0);
+  CHECK(find_tmc_messages(dec.oda, 109, found, 4) == 0);
+
+  // The other direction runs back the other way.
+  dec.Single(1, 101, 110, 2, true);
+  CHECK(find_tmc_messages(dec.oda, 108, found, 4) == 1);
+  CHECK(find_tmc_messages(dec.oda, 110, found, 4) == 2);
+  CheckLocationIndex(index, dec);
+}
+
+// More extent locations than fit in the index are still found.
+void TestFullIndex(const struct tmc_location_index* index) {
+  Decoder dec;
+  set_tmc_location_index(dec.oda, index);
+  dec.SetLTN(1);
+  FreeFormat ff;
+  ff.Label(1, 6).Label(1, 7);  // Extent +8 and +16.
+  for (uint16_t i = 0; i < TMC_MAX_MESSAGES; i++) {
+    dec.Group(1, 0x8000 | 7 << 11 | (1 + i), 100);
+    dec.Group(1, 0x4000 | ff.Group(0) >> 16, ff.Group(0) & 0xFFFF);
+  }
+  CHECK(dec.count() == TMC_MAX_MESSAGES && dec.msg(0).extent == 31);
+  CHECK(dec.oda->tmc.location_ref_cnt == TMC_MAX_LOCATION_REFS);
+  const struct tmc_message* found[TMC_MAX_MESSAGES];
+  CHECK(find_tmc_messages(dec.oda, 131, found, TMC_MAX_MESSAGES) ==
+        TMC_MAX_MESSAGES);
+  CHECK(find_tmc_messages(dec.oda, 132, found, TMC_MAX_MESSAGES) == 0);
+  CheckLocationIndex(index, dec);
+
+  set_oda_time(dec.oda, 1000 + 24 * 60 * 60);
+  CHECK(dec.count() == 0);
+  CHECK(dec.oda->tmc.location_ref_cnt == 0);
+  CHECK(dec.oda->tmc.extent_ref_cnt == 0);
+}
+
+// Random updates, evictions and expiry keep the index consistent.
+void TestRandomMessages(const struct tmc_location_index* index) {
+  Decoder dec;
+  set_tmc_location_index(dec.oda, index);
+  dec.SetLTN(1);
+  srand(1);
+  uint32_t now = 1000;
+  for (int i = 0; i < 5000; i++) {
+    dec.Single(rand() % 8, 101 + rand() % 4, 95 + rand() % 50,
+               rand() % 16, rand() % 2);
+    if (rand() % 16 == 0)
+      set_oda_time(dec.oda, now += rand() % 1200);
+    if (i % 16 == 0)
+      CheckLocationIndex(index, dec);
+  }
+  CheckLocationIndex(index, dec);
+}
+
+void BenchmarkDecoding() {
+  Decoder dec;
+  Benchmark("TMC single group", 10000000, [&dec](uint32_t i) {
+    dec.Single(1, 101 + i % 8, 1000 + i % 64);
+    return dec.count();
+  });
+  FreeFormat ff;
+  ff.Label(10, 0x1234).Label(4, 7).Label(0, 2);
+  const uint32_t g0 = ff.Group(0);
+  const uint32_t g1 = ff.Group(1);
+  Benchmark("TMC 3 group message", 5000000, [&](uint32_t i) {
+    const uint8_t ci = i % 7 + 1;
+    const uint16_t location = 2000 + i % 64;
+    dec.Group(ci, 0x8000 | 401, location);
+    dec.Group(ci, 0x4000 | 1 << 12 | g0 >> 16, g0 & 0xFFFF);
+    dec.Group(ci, g1 >> 16, g1 & 0xFFFF);
+    return dec.count();
+  });
+}
+
+}  // namespace
+
+// Lookups with every location in the index, and with extents which don't fit
+// (so that they are scanned).
+void BenchmarkLocationLookups(const struct tmc_location_index* index) {
+  for (uint8_t max_extent : {3, 7}) {
+    Decoder dec;
+    set_tmc_location_index(dec.oda, index);
+    dec.SetLTN(1);
+    for (uint16_t i = 0; i < TMC_MAX_MESSAGES; i++)
+      dec.Single(7, 101 + i % 4, 100 + i, i % (max_extent + 1));
+    const char* name = dec.oda->tmc.location_ref_cnt < TMC_MAX_LOCATION_REFS
+                           ? "find_tmc_messages (indexed)"
+                           : "find_tmc_messages (index full)";
+    Benchmark(name, 5000000, [&dec](uint32_t i) {
+      const struct tmc_message* found[4];
+      return find_tmc_messages(dec.oda, 100 + i % 40, found, 4);
+    });
+  }
+}
+
+int main(int argc, const char** argv) {
+  if (argc != 2) {
+    fprintf(stderr, "usage: %s <location index file>\n", argv[0]);
+    return 2;
+  }
+  struct tmc_location_index* index = open_tmc_location_index(argv[1]);
+  CHECK(index != nullptr);
+  if (!index)
+    return TestResult();
+  TestSingleGroup();
+  TestDefaultDuration();
+  TestMultiGroup();
+  TestLongMultiGroup();
+  TestLostGroup();
+  TestPool();
+  TestExtents(index);
+  TestFullIndex(index);
+  TestRandomMessages(index);
+  BenchmarkDecoding();
+  BenchmarkLocationLookups(index);
+  close_tmc_location_index(index);
+  printf("sizeof(struct rds_oda_data): %zu\n", sizeof(struct rds_oda_data));
+  return TestResult();
+}
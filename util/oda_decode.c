@@ -19,23 +19,30 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "tmc_events.h"
+#include "tmc_locations.h"
+
 #define UNUSED(expr) \
   do {               \
     (void)(expr);    \
   } while (0)
 
-// clang-format off
-//
-// http://www.rds.org.uk/2010/pdf/R17_032_1.pdf
-#define AID_RT_PLUS 0x4BD7 // Radiotext Plus (RT+).
-#define AID_TMC     0xCD46
-#define AID_ITUNES  0xC3B0 // iTunes tagging.
+#if !defined(ARRAY_SIZE)
+#define ARRAY_SIZE(ARRAY) (sizeof(ARRAY) / sizeof((ARRAY)[0]))
+#endif
 
-// clang-format on
+// The first hash multiplier tried when (re)hashing the ODA decoder table.
+#define ODA_INITIAL_SEED 0x9E3779B1
 
-struct rds_oda_data* create_oda_data() {
-  return (struct rds_oda_data*)calloc(1, sizeof(struct rds_oda_data));
-}
+// The number of multipliers to try before giving up on a perfect hash.
+#define ODA_MAX_SEED_TRIES 1024
+
+// RT+ content types of the item text kept in the play history.
+#define RTPLUS_ITEM_TITLE 1
+#define RTPLUS_ITEM_ARTIST 4
+
+// The last of the ITEM.* content types (ITEM.TITLE to ITEM.GENRE).
+#define RTPLUS_ITEM_LAST 11
 
 void delete_oda_data(struct rds_oda_data* oda_data) {
   if (!oda_data)
@@ -44,16 +51,126 @@ void delete_oda_data(struct rds_oda_data* oda_data) {
 }
 
 /**
- * Decode Radiotext plus (RT+) data.
- *
- * See https://tech.ebu.ch/docs/techreview/trev_307-radiotext.pdf
+ * Get the index in tags->tag[] for |content_type|, or the index at which it
+ * would be inserted (to keep the tags sorted) if it isn't there.
  */
-static void decode_rt_plus(struct rds_oda_data* oda,
+static uint8_t find_tag_index(const struct rds_oda_tags* tags,
+                              uint8_t content_type) {
+  uint8_t idx = 0;
+  while (idx < tags->count && tags->tag[idx].content_type < content_type)
+    idx++;
+  return idx;
+}
+
+static void remove_tag_at(struct rds_oda_tags* tags, uint8_t idx) {
+  const uint64_t bit = UINT64_C(1) << tags->tag[idx].content_type;
+  tags->active &= ~bit;
+  tags->changed |= bit;
+  tags->count--;
+  memmove(&tags->tag[idx], &tags->tag[idx + 1],
+          (tags->count - idx) * sizeof(tags->tag[0]));
+}
+
+/**
+ * Remove the tag, if any, for |content_type|.
+ */
+static void remove_tag(struct rds_oda_tags* tags, uint8_t content_type) {
+  if (!(tags->active & (UINT64_C(1) << content_type)))
+    return;
+  remove_tag_at(tags, find_tag_index(tags, content_type));
+}
+
+/**
+ * Add (or replace) the tag for |content_type|. If all slots are in use then
+ * the tag received for the oldest RadioText is dropped.
+ */
+static void set_tag(struct rds_oda_tags* tags,
+                    uint8_t content_type,
+                    uint8_t start,
+                    uint8_t length,
+                    const struct rds_rt* rt) {
+  const uint8_t kRTLen = sizeof(rt->display);
+  if (start >= kRTLen)
+    return;
+  if (length > kRTLen - start)
+    length = kRTLen - start;
+
+  const uint64_t bit = UINT64_C(1) << content_type;
+  uint8_t idx = find_tag_index(tags, content_type);
+  if (!(tags->active & bit)) {
+    if (tags->count == ODA_MAX_TAGS) {
+      uint8_t oldest = 0;
+      for (uint8_t i = 1; i < tags->count; i++) {
+        if ((int16_t)(tags->tag[i].rt_gen - tags->tag[oldest].rt_gen) < 0)
+          oldest = i;
+      }
+      remove_tag_at(tags, oldest);
+      if (oldest < idx)
+        idx--;
+    }
+    memmove(&tags->tag[idx + 1], &tags->tag[idx],
+            (tags->count - idx) * sizeof(tags->tag[0]));
+    tags->count++;
+    tags->active |= bit;
+    tags->tag[idx].content_type = content_type;
+  } else if (tags->tag[idx].start == start &&
+             tags->tag[idx].length == length &&
+             tags->tag[idx].rt_gen == tags->rt_gen) {
+    return;
+  }
+  tags->changed |= bit;
+  tags->tag[idx].start = start;
+  tags->tag[idx].length = length;
+  tags->tag[idx].rt = tags->last_rt;
+  tags->tag[idx].rt_gen = tags->rt_gen;
+}
+
+/**
+ * Track the RadioText A/B flag - a flip means a new RadioText message.
+ */
+static void update_rt_gen(struct rds_oda_tags* tags,
+                          const struct rds_data* rds) {
+  if (rds->rt.decode_rt != tags->last_rt) {
+    tags->last_rt = rds->rt.decode_rt;
+    tags->rt_gen++;
+  }
+}
+
+static void clear_tags(struct rds_oda_tags* tags) {
+  tags->changed |= tags->active;
+  tags->active = 0;
+  tags->count = 0;
+}
+
+const struct rds_oda_tag* find_oda_tag(const struct rds_oda_tags* tags,
+                                       uint8_t content_type) {
+  if (content_type > 63 || !(tags->active & (UINT64_C(1) << content_type)))
+    return NULL;
+  return &tags->tag[find_tag_index(tags, content_type)];
+}
+
+uint64_t consume_oda_tag_changes(struct rds_oda_tags* tags) {
+  const uint64_t changed = tags->changed;
+  tags->changed = 0;
+  return changed;
+}
+
+const char* get_oda_tag_text(const struct rds_oda_tag* tag,
+                             const struct rds_data* rds,
+                             size_t* len) {
+  const struct rds_rt* rt = tag->rt == RT_A ? &rds->rt.a : &rds->rt.b;
+  *len = tag->length;
+  return (const char*)&rt->display[tag->start];
+}
+
+/**
+ * Decode the tags in an RT+ style group into |tags|. Each group carries up to
+ * two tags, each a content type and a span (start, length) of the RadioText.
+ */
+static void decode_rt_tags(struct rds_oda_tags* tags,
                            const struct rds_data* rds,
                            const struct rds_blocks* blocks) {
   // clang-format off
-  //const uint16_t B_ITEM_TOGGLE     = 0b0000000000010000;
-  //const uint16_t B_ITEM_RUNNING    = 0b0000000000001000;
   const uint16_t B_CONTENT_TYPE_1  = 0b0000000000000111;
   const uint16_t C_CONTENT_TYPE_1  = 0b1110000000000000;
   const uint16_t C_START_MARKER_1  = 0b0001111110000000;
@@ -71,8 +188,8 @@ static void decode_rt_plus(struct rds_oda_data* oda,
   if (blocks->d.errors > BLERD_MAX)
     return;
 
-  // const bool item_toggle = blocks->b.val & B_ITEM_TOGGLE;
-  // const bool item_running = blocks->b.val & B_ITEM_RUNNING;
+  update_rt_gen(tags, rds);
+
   const uint16_t content_type1 = ((blocks->b.val & B_CONTENT_TYPE_1) << 3) |
                                  ((blocks->c.val & C_CONTENT_TYPE_1) >> 13);
   uint16_t start = (blocks->c.val & C_START_MARKER_1) >> 7;
@@ -81,14 +198,10 @@ static void decode_rt_plus(struct rds_oda_data* oda,
   const struct rds_rt* rt = rds->rt.decode_rt == RT_A ? &rds->rt.a : &rds->rt.b;
 
   if (content_type1 > 0 && content_type1 <= 63) {  // Valid content type.
-    if ((length == 0 && rt->display[start] == ' ')) {
-      memset(oda->rtplus.text[content_type1], 0,
-             sizeof(oda->rtplus.text[content_type1]));
-    } else {
-      memset(oda->rtplus.text[content_type1], 0,
-             sizeof(oda->rtplus.text[content_type1]));
-      memcpy(oda->rtplus.text[content_type1], &rt->display[start], length + 1);
-    }
+    if ((length == 0 && rt->display[start] == ' '))
+      remove_tag(tags, content_type1);
+    else
+      set_tag(tags, content_type1, start, length + 1, rt);
   }
 
   const uint16_t content_type2 = ((blocks->c.val & C_CONTENT_TYPE_2) << 5) |
@@ -99,16 +212,125 @@ static void decode_rt_plus(struct rds_oda_data* oda,
   if (content_type2 > 0 && content_type2 <= 63) {  // Valid content type.
     if ((content_type1 != content_type2) && length == 0 &&
         rt->display[start] == ' ') {
-      memset(oda->rtplus.text[content_type2], 0,
-             sizeof(oda->rtplus.text[content_type2]));
+      remove_tag(tags, content_type2);
     } else {
-      memset(oda->rtplus.text[content_type2], 0,
-             sizeof(oda->rtplus.text[content_type2]));
-      memcpy(oda->rtplus.text[content_type2], &rt->display[start], length + 1);
+      set_tag(tags, content_type2, start, length + 1, rt);
     }
   }
 }
 
+/**
+ * Copy the text of tag |content_type| to |dst|, which is emptied if there is
+ * no such tag.
+ */
+static void copy_tag_text(char dst[RTPLUS_ITEM_TEXT_LEN + 1],
+                          const struct rds_oda_tags* tags,
+                          uint8_t content_type,
+                          const struct rds_data* rds) {
+  const struct rds_oda_tag* tag = find_oda_tag(tags, content_type);
+  if (!tag) {
+    dst[0] = '\0';
+    return;
+  }
+  size_t len;
+  const char* text = get_oda_tag_text(tag, rds, &len);
+  while (len && text[len - 1] == ' ')
+    len--;
+  if (len > RTPLUS_ITEM_TEXT_LEN)
+    len = RTPLUS_ITEM_TEXT_LEN;
+  memcpy(dst, text, len);
+  dst[len] = '\0';
+}
+
+/**
+ * Append the running item to the history ring (if it has any text) and start
+ * a new one.
+ */
+static void end_rtplus_item(struct rds_oda_data* oda) {
+  struct rtplus_history* history = &oda->rtplus_history;
+  if (history->current.title[0] || history->current.artist[0]) {
+    struct rtplus_item* item =
+        &history->items[history->count % RTPLUS_HISTORY_SIZE];
+    *item = history->current;
+    item->ended = oda->now;
+    history->count++;
+  }
+  memset(&history->current, 0, sizeof(history->current));
+  history->current.started = oda->now;
+}
+
+/**
+ * Track item boundaries. An item ends when the item toggle bit changes or the
+ * item running bit is cleared, and a new one starts when the toggle changes
+ * or the running bit is set. A toggle also removes the old item's ITEM.*
+ * tags, whose spans don't apply to the new item's RadioText.
+ */
+static void update_rtplus_item(struct rds_oda_data* oda,
+                               const struct rds_blocks* blocks) {
+  // clang-format off
+  const uint16_t B_ITEM_TOGGLE     = 0b0000000000010000;
+  const uint16_t B_ITEM_RUNNING    = 0b0000000000001000;
+  // clang-format on
+
+  struct rtplus_history* history = &oda->rtplus_history;
+  const bool item_toggle = blocks->b.val & B_ITEM_TOGGLE;
+  const bool item_running = blocks->b.val & B_ITEM_RUNNING;
+  if (!history->have_bits) {
+    history->have_bits = true;
+    history->current.started = oda->now;
+  } else if (item_toggle != history->item_toggle) {
+    end_rtplus_item(oda);
+    for (uint8_t type = RTPLUS_ITEM_TITLE; type <= RTPLUS_ITEM_LAST; type++)
+      remove_tag(&oda->rtplus, type);
+  } else if (history->item_running && !item_running) {
+    end_rtplus_item(oda);
+  } else if (!history->item_running && item_running) {
+    history->current.started = oda->now;
+  }
+  history->item_toggle = item_toggle;
+  history->item_running = item_running;
+}
+
+/**
+ * Decode Radiotext plus (RT+) data.
+ *
+ * See https://tech.ebu.ch/docs/techreview/trev_307-radiotext.pdf
+ */
+static void decode_rt_plus(struct rds_oda_data* oda,
+                           void* state,
+                           const struct rds_data* rds,
+                           const struct rds_blocks* blocks,
+                           struct rds_group_type gt) {
+  UNUSED(state);
+  UNUSED(gt);
+  if (blocks->b.errors > BLERB_MAX)
+    return;
+  update_rtplus_item(oda, blocks);
+  decode_rt_tags(&oda->rtplus, rds, blocks);
+  // The item's text is copied while it runs because the RadioText (which
+  // the tags reference) has usually moved on by the time the item ends.
+  if (oda->rtplus_history.item_running) {
+    copy_tag_text(oda->rtplus_history.current.title, &oda->rtplus,
+                  RTPLUS_ITEM_TITLE, rds);
+    copy_tag_text(oda->rtplus_history.current.artist, &oda->rtplus,
+                  RTPLUS_ITEM_ARTIST, rds);
+  }
+}
+
+const struct rtplus_item* get_next_rtplus_item(
+    const struct rds_oda_data* oda_data,
+    uint32_t* cursor) {
+  const struct rtplus_history* history = &oda_data->rtplus_history;
+  const uint32_t oldest = history->count > RTPLUS_HISTORY_SIZE
+                              ? history->count - RTPLUS_HISTORY_SIZE
+                              : 0;
+  if (*cursor < oldest || *cursor > history->count)
+    *cursor = oldest;
+  if (*cursor == history->count)
+    return NULL;
+  return &history->items[(*cursor)++ % RTPLUS_HISTORY_SIZE];
+}
+
 static void decode_tmc_system_var0(struct rds_oda_data* data,
                                    const struct rds_blocks* blocks) {
   // clang-format off
@@ -153,16 +375,483 @@ static void decode_tmc_system_var1(struct rds_oda_data* data,
   data->tmc.system.variant.v1.td = blocks->c.val & C_TMC_VARI_1_TD;
 }
 
+// clang-format off
+
+#define B_TMC_TUNING      0b0000000000010000
+#define B_TMC_F           0b0000000000001000
+#define B_TMC_DP          0b0000000000000111
+#define B_TMC_CI          0b0000000000000111
+#define C_TMC_DIVERSION   0b1000000000000000
+#define C_TMC_FG          0b1000000000000000
+#define C_TMC_DIRECTION   0b0100000000000000
+#define C_TMC_SG          0b0100000000000000
+#define C_TMC_EXTENT      0b0011100000000000
+#define C_TMC_GSI         0b0011000000000000
+#define C_TMC_EVENT       0b0000011111111111
+#define C_TMC_FREE_FORMAT 0b0000111111111111
+
+// clang-format on
+
+/**
+ * The number of seconds a message persists for each duration and persistence
+ * value (ISO 14819-1 table 2). The last ("rest of the day") is approximated
+ * as 24 hours.
+ */
+static const uint32_t kTMCPersistence[8] = {
+    15 * 60, 15 * 60, 30 * 60, 60 * 60, 2 * 60 * 60, 3 * 60 * 60, 4 * 60 * 60,
+    24 * 60 * 60,
+};
+
+/**
+ * The size, in bits, of the data following each free format label
+ * (ISO 14819-1 table 6). Label 15 is reserved and ends parsing.
+ */
+static const uint8_t kTMCLabelSizes[16] = {3, 3,  5,  5,  5,  8,  8, 8,
+                                           8, 11, 16, 16, 16, 16, 0, 0};
+
+#define TMC_LABEL_DURATION 0
+#define TMC_LABEL_CONTROL 1
+#define TMC_LABEL_QUANTIFIER_5 4
+#define TMC_LABEL_QUANTIFIER_8 5
+#define TMC_LABEL_RESERVED 15
+
+#define TMC_CONTROL_INCREASE_URGENCY 0
+#define TMC_CONTROL_REDUCE_URGENCY 1
+#define TMC_CONTROL_SET_DIVERSION 5
+#define TMC_CONTROL_EXTENT_PLUS_8 6
+#define TMC_CONTROL_EXTENT_PLUS_16 7
+
+static void append_free_format_bits(struct tmc_message* msg,
+                                    uint32_t val,
+                                    uint8_t num_bits) {
+  while (num_bits && msg->free_format_bits < TMC_MAX_FREE_FORMAT_BITS) {
+    num_bits--;
+    const uint8_t idx = msg->free_format_bits / 8;
+    const uint8_t shift = 7 - msg->free_format_bits % 8;
+    if (val & (1u << num_bits))
+      msg->free_format[idx] |= 1u << shift;
+    msg->free_format_bits++;
+  }
+}
+
+static uint32_t get_free_format_bits(const struct tmc_message* msg,
+                                     uint8_t pos,
+                                     uint8_t num_bits) {
+  uint32_t val = 0;
+  for (; num_bits; num_bits--, pos++) {
+    const uint8_t bit = (msg->free_format[pos / 8] >> (7 - pos % 8)) & 1u;
+    val = (val << 1) | bit;
+  }
+  return val;
+}
+
+static bool free_format_bits_zero(const struct tmc_message* msg, uint8_t pos) {
+  for (; pos < msg->free_format_bits; pos++) {
+    if (msg->free_format[pos / 8] & (0x80u >> (pos % 8)))
+      return false;
+  }
+  return true;
+}
+
+/**
+ * Apply the free format labels that modify the basic message. The other
+ * labels are left in |msg->free_format| for the caller to interpret.
+ */
+static void apply_free_format(struct tmc_message* msg) {
+  uint8_t pos = 0;
+  while (msg->free_format_bits - pos >= 4) {
+    // Unused bits at the end of the last group are zero filled.
+    if (free_format_bits_zero(msg, pos))
+      break;
+    const uint8_t remaining = msg->free_format_bits - pos;
+    const uint8_t label = get_free_format_bits(msg, pos, 4);
+    pos += 4;
+    if (label == TMC_LABEL_RESERVED || kTMCLabelSizes[label] > remaining - 4)
+      break;
+    const uint32_t val = get_free_format_bits(msg, pos, kTMCLabelSizes[label]);
+    pos += kTMCLabelSizes[label];
+    if (label == TMC_LABEL_DURATION) {
+      msg->duration = val;
+    } else if (label == TMC_LABEL_QUANTIFIER_5 ||
+               label == TMC_LABEL_QUANTIFIER_8) {
+      // Only the first quantifier applies to the (first) event.
+      if (!msg->has_quantifier) {
+        msg->has_quantifier = true;
+        msg->quantifier = val;
+      }
+    } else if (label == TMC_LABEL_CONTROL) {
+      if (val == TMC_CONTROL_INCREASE_URGENCY)
+        msg->urgency = (msg->urgency + 1) % 3;
+      else if (val == TMC_CONTROL_REDUCE_URGENCY)
+        msg->urgency = (msg->urgency + 2) % 3;
+      else if (val == TMC_CONTROL_SET_DIVERSION)
+        msg->diversion = true;
+      else if (val == TMC_CONTROL_EXTENT_PLUS_8)
+        msg->extent += 8;
+      else if (val == TMC_CONTROL_EXTENT_PLUS_16)
+        msg->extent += 16;
+    }
+  }
+}
+
+/**
+ * Set the urgency of |msg| to its event's default, and its duration to the
+ * event's default duration if the message gave none.
+ */
+static void set_tmc_event_defaults(struct tmc_message* msg) {
+  struct tmc_event_info info;
+  get_tmc_event_info(msg->event, &info);
+  msg->urgency = info.urgency;
+  if (!msg->duration)
+    msg->duration = info.default_duration;
+}
+
+/**
+ * The first location ref for |location| (or where it would be inserted).
+ */
+static uint32_t lower_bound_location_ref(const struct rds_oda_data* data,
+                                         uint16_t location) {
+  uint32_t lo = 0;
+  uint32_t hi = data->tmc.location_ref_cnt;
+  while (lo < hi) {
+    const uint32_t mid = lo + (hi - lo) / 2;
+    if (data->tmc.location_refs[mid].location < location)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+// Room is reserved for the primary location of every message.
+#if TMC_MAX_LOCATION_REFS < TMC_MAX_MESSAGES
+#error "TMC_MAX_LOCATION_REFS must be at least TMC_MAX_MESSAGES"
+#endif
+static const uint32_t kMaxExtentRefs =
+    TMC_MAX_LOCATION_REFS - TMC_MAX_MESSAGES;
+
+static void insert_location_ref(struct rds_oda_data* data,
+                                uint16_t location,
+                                uint16_t msg) {
+  const uint32_t pos = lower_bound_location_ref(data, location);
+  struct tmc_location_ref* refs = data->tmc.location_refs;
+  memmove(&refs[pos + 1], &refs[pos],
+          (data->tmc.location_ref_cnt - pos) * sizeof(*refs));
+  refs[pos].location = location;
+  refs[pos].msg = msg;
+  data->tmc.location_ref_cnt++;
+}
+
+/**
+ * Get every location affected by |msg|: the primary location and the
+ * |extent| locations following it. The extent runs back from the primary
+ * location against the direction of travel, so the location table offsets
+ * are followed in the opposite direction. Returns the number of locations.
+ */
+static uint8_t get_tmc_message_locations(
+    const struct rds_oda_data* data,
+    const struct tmc_message* msg,
+    uint16_t locations[TMC_MAX_MESSAGE_LOCATIONS]) {
+  uint8_t count = 0;
+  locations[count++] = msg->location;
+  while (count <= msg->extent && count < TMC_MAX_MESSAGE_LOCATIONS) {
+    struct tmc_location loc;
+    if (!get_tmc_location(data->tmc.locations, data->tmc.ltn,
+                          locations[count - 1], &loc))
+      break;
+    const uint16_t next = msg->pos_dir ? loc.neg_offset : loc.pos_offset;
+    if (!next)
+      break;
+    locations[count++] = next;
+  }
+  return count;
+}
+
+/**
+ * Find the location ref for message |idx| at |location|. Returns
+ * |location_ref_cnt| if there is none.
+ */
+static uint32_t find_location_ref(const struct rds_oda_data* data,
+                                  uint16_t location,
+                                  uint16_t idx) {
+  uint32_t i = lower_bound_location_ref(data, location);
+  for (; i < data->tmc.location_ref_cnt &&
+         data->tmc.location_refs[i].location == location;
+       i++) {
+    if (data->tmc.location_refs[i].msg == idx)
+      return i;
+  }
+  return data->tmc.location_ref_cnt;
+}
+
+/**
+ * Add message |idx| to the location index. The primary location always fits
+ * as there is room reserved for one per message; extent locations are added
+ * while there is room for them.
+ */
+static void index_tmc_message(struct rds_oda_data* data, uint16_t idx) {
+  struct tmc_message* msg = &data->tmc.messages[idx];
+  uint16_t locations[TMC_MAX_MESSAGE_LOCATIONS];
+  msg->location_cnt = get_tmc_message_locations(data, msg, locations);
+  insert_location_ref(data, locations[0], idx);
+  msg->indexed_cnt = 1;
+  while (msg->indexed_cnt < msg->location_cnt &&
+         data->tmc.extent_ref_cnt < kMaxExtentRefs) {
+    insert_location_ref(data, locations[msg->indexed_cnt++], idx);
+    data->tmc.extent_ref_cnt++;
+  }
+}
+
+/**
+ * Remove message |idx| from the location index.
+ */
+static void unindex_tmc_message(struct rds_oda_data* data, uint16_t idx) {
+  const struct tmc_message* msg = &data->tmc.messages[idx];
+  uint16_t locations[TMC_MAX_MESSAGE_LOCATIONS];
+  get_tmc_message_locations(data, msg, locations);
+  struct tmc_location_ref* refs = data->tmc.location_refs;
+  for (uint8_t i = 0; i < msg->indexed_cnt; i++) {
+    const uint32_t pos = find_location_ref(data, locations[i], idx);
+    if (pos == data->tmc.location_ref_cnt)
+      continue;
+    data->tmc.location_ref_cnt--;
+    memmove(&refs[pos], &refs[pos + 1],
+            (data->tmc.location_ref_cnt - pos) * sizeof(*refs));
+    if (i)
+      data->tmc.extent_ref_cnt--;
+  }
+}
+
+/**
+ * Renumber the location refs of the message at |idx| (which was |old_idx|).
+ * The index is sorted by location only, so it remains sorted.
+ */
+static void renumber_tmc_message(struct rds_oda_data* data,
+                                 uint16_t old_idx,
+                                 uint16_t idx) {
+  const struct tmc_message* msg = &data->tmc.messages[idx];
+  uint16_t locations[TMC_MAX_MESSAGE_LOCATIONS];
+  get_tmc_message_locations(data, msg, locations);
+  for (uint8_t i = 0; i < msg->indexed_cnt; i++) {
+    const uint32_t pos = find_location_ref(data, locations[i], old_idx);
+    if (pos != data->tmc.location_ref_cnt)
+      data->tmc.location_refs[pos].msg = idx;
+  }
+}
+
+static void reindex_tmc_messages(struct rds_oda_data* data) {
+  data->tmc.location_ref_cnt = 0;
+  data->tmc.extent_ref_cnt = 0;
+  for (uint16_t i = 0; i < data->tmc.message_cnt; i++)
+    index_tmc_message(data, i);
+}
+
+static void remove_tmc_message_at(struct rds_oda_data* data, uint16_t idx) {
+  unindex_tmc_message(data, idx);
+  data->tmc.message_cnt--;
+  const uint16_t last = data->tmc.message_cnt;
+  if (idx == last)
+    return;
+  data->tmc.messages[idx] = data->tmc.messages[last];
+  renumber_tmc_message(data, last, idx);
+}
+
+static void expire_tmc_messages(struct rds_oda_data* data) {
+  uint16_t i = 0;
+  while (i < data->tmc.message_cnt) {
+    if ((int32_t)(data->tmc.messages[i].expires - data->now) <= 0)
+      remove_tmc_message_at(data, i);
+    else
+      i++;
+  }
+}
+
+/**
+ * Find the message with the same event, location and direction as |msg|.
+ * Returns TMC_MAX_MESSAGES if there is none.
+ */
+static uint16_t find_tmc_message(const struct rds_oda_data* data,
+                                 const struct tmc_message* msg) {
+  for (uint32_t i = lower_bound_location_ref(data, msg->location);
+       i < data->tmc.location_ref_cnt &&
+       data->tmc.location_refs[i].location == msg->location;
+       i++) {
+    const uint16_t idx = data->tmc.location_refs[i].msg;
+    const struct tmc_message* m = &data->tmc.messages[idx];
+    if (m->event == msg->event && m->location == msg->location &&
+        m->pos_dir == msg->pos_dir)
+      return idx;
+  }
+  return TMC_MAX_MESSAGES;
+}
+
+/**
+ * Add |msg| to the message pool. A message with the same event, location, and
+ * direction as an existing one is an update (or repeat) of that message. When
+ * the pool is full the message expiring soonest is evicted.
+ */
+static void add_tmc_message(struct rds_oda_data* data,
+                            const struct tmc_message* msg) {
+  uint16_t idx = find_tmc_message(data, msg);
+  uint32_t received = data->now;
+  bool reindex = true;
+  if (idx != TMC_MAX_MESSAGES) {
+    received = data->tmc.messages[idx].received;
+    reindex = data->tmc.messages[idx].extent != msg->extent;
+    if (reindex)
+      unindex_tmc_message(data, idx);
+  } else if (data->tmc.message_cnt < TMC_MAX_MESSAGES) {
+    idx = data->tmc.message_cnt++;
+  } else {
+    idx = 0;
+    for (uint16_t i = 1; i < data->tmc.message_cnt; i++) {
+      if ((int32_t)(data->tmc.messages[i].expires -
+                    data->tmc.messages[idx].expires) < 0)
+        idx = i;
+    }
+    unindex_tmc_message(data, idx);
+  }
+
+  struct tmc_message* dst = &data->tmc.messages[idx];
+  const uint8_t location_cnt = dst->location_cnt;
+  const uint8_t indexed_cnt = dst->indexed_cnt;
+  *dst = *msg;
+  dst->location_cnt = location_cnt;
+  dst->indexed_cnt = indexed_cnt;
+  dst->received = received;
+  dst->updated = data->now;
+  dst->expires = data->now + kTMCPersistence[dst->duration & 0x7];
+  if (reindex)
+    index_tmc_message(data, idx);
+}
+
+static void decode_tmc_single_group(struct rds_oda_data* data) {
+  struct tmc_message msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.event = data->tmc.group.event;
+  msg.location = data->tmc.group.location;
+  msg.extent = data->tmc.group.extent;
+  msg.duration = data->tmc.group.dp;
+  msg.pos_dir = data->tmc.group.pos_dir;
+  msg.diversion = data->tmc.group.diversion;
+  set_tmc_event_defaults(&msg);
+  add_tmc_message(data, &msg);
+}
+
+/**
+ * Decode one group of a multi-group message (ISO 14819-1 section 7.6).
+ * Groups are collected per continuity index until the last group (GSI=0)
+ * is received. Repeats of a group already received are ignored.
+ */
+static void decode_tmc_multi_group(struct rds_oda_data* data,
+                                   const struct rds_blocks* blocks) {
+  struct tmc_assembly* asmb = &data->tmc.assembly[blocks->b.val & B_TMC_CI];
+  const uint16_t c = blocks->c.val;
+  const uint16_t d = blocks->d.val;
+
+  if (c & C_TMC_FG) {
+    if (asmb->active && asmb->first_c == c && asmb->first_d == d)
+      return;  // Repeat of the first group.
+    memset(asmb, 0, sizeof(*asmb));
+    asmb->active = true;
+    asmb->next_gsi = 0xff;  // Unknown until the second group.
+    asmb->first_c = c;
+    asmb->first_d = d;
+    asmb->msg.multi_group = true;
+    asmb->msg.pos_dir = c & C_TMC_DIRECTION;
+    asmb->msg.extent = (c & C_TMC_EXTENT) >> 11;
+    asmb->msg.event = c & C_TMC_EVENT;
+    asmb->msg.location = d;
+    set_tmc_event_defaults(&asmb->msg);
+    return;
+  }
+
+  if (!asmb->active)
+    return;
+  const uint8_t gsi = (c & C_TMC_GSI) >> 12;
+  if (c & C_TMC_SG) {
+    if (asmb->next_gsi != 0xff)
+      return;  // Repeat of the second group.
+  } else if (gsi != asmb->next_gsi) {
+    if (asmb->next_gsi == 0xff || gsi != asmb->next_gsi + 1)
+      asmb->active = false;  // Lost a group.
+    return;
+  }
+
+  append_free_format_bits(&asmb->msg, c & C_TMC_FREE_FORMAT, 12);
+  append_free_format_bits(&asmb->msg, d, 16);
+  if (gsi) {
+    asmb->next_gsi = gsi - 1;
+    return;
+  }
+  asmb->active = false;
+  apply_free_format(&asmb->msg);
+  add_tmc_message(data, &asmb->msg);
+}
+
+void set_oda_time(struct rds_oda_data* oda_data, uint32_t now) {
+  if (now == oda_data->now)
+    return;
+  oda_data->now = now;
+  expire_tmc_messages(oda_data);
+}
+
+void set_tmc_location_index(struct rds_oda_data* oda_data,
+                            const struct tmc_location_index* locations) {
+  oda_data->tmc.locations = locations;
+  reindex_tmc_messages(oda_data);
+}
+
+size_t find_tmc_messages(const struct rds_oda_data* oda_data,
+                         uint16_t location,
+                         const struct tmc_message** messages,
+                         size_t max_messages) {
+  size_t count = 0;
+  for (uint32_t i = lower_bound_location_ref(oda_data, location);
+       i < oda_data->tmc.location_ref_cnt &&
+       oda_data->tmc.location_refs[i].location == location;
+       i++) {
+    if (count < max_messages) {
+      messages[count] =
+          &oda_data->tmc.messages[oda_data->tmc.location_refs[i].msg];
+    }
+    count++;
+  }
+  // Extent locations which did not fit in the index.
+  for (uint16_t m = 0; m < oda_data->tmc.message_cnt; m++) {
+    const struct tmc_message* msg = &oda_data->tmc.messages[m];
+    if (msg->indexed_cnt == msg->location_cnt)
+      continue;
+    uint16_t locations[TMC_MAX_MESSAGE_LOCATIONS];
+    get_tmc_message_locations(oda_data, msg, locations);
+    for (uint8_t i = msg->indexed_cnt; i < msg->location_cnt; i++) {
+      if (locations[i] != location)
+        continue;
+      if (count < max_messages)
+        messages[count] = msg;
+      count++;
+      break;
+    }
+  }
+  return count;
+}
+
 /**
  * Decode the RTL-TMC data stored in group 3A.
  */
 static void decode_tmc_3A(struct rds_oda_data* data,
                           const struct rds_blocks* blocks) {
   data->tmc.system.variant_code = (blocks->c.val & C_TMC_VARIANT) >> 14;
-  if (data->tmc.system.variant_code == 0)
+  if (data->tmc.system.variant_code == 0) {
     decode_tmc_system_var0(data, blocks);
-  else
+    if (data->tmc.ltn != data->tmc.system.variant.v0.ltn) {
+      // Extents can only be resolved with the station's location table.
+      data->tmc.ltn = data->tmc.system.variant.v0.ltn;
+      reindex_tmc_messages(data);
+    }
+  } else {
     decode_tmc_system_var1(data, blocks);
+  }
 }
 
 /**
@@ -170,18 +859,6 @@ static void decode_tmc_3A(struct rds_oda_data* data,
  */
 static void decode_tmc_8A(struct rds_oda_data* data,
                           const struct rds_blocks* blocks) {
-  // clang-format off
-
-#define B_TMC_TUNING      0b0000000000010000
-#define B_TMC_F           0b0000000000001000
-#define B_TMC_DP          0b0000000000000111
-#define C_TMC_DIVERSION   0b1000000000000000
-#define C_TMC_DIRECTION   0b0100000000000000
-#define C_TMC_EXTENT      0b0011100000000000
-#define C_TMC_EVENT       0b0000011111111111
-
-  // clang-format on
-
   data->tmc.group.tuning = blocks->b.val & B_TMC_TUNING;
   data->tmc.group.single_group = blocks->b.val & B_TMC_F;
   data->tmc.group.dp = blocks->b.val & B_TMC_DP;
@@ -190,14 +867,25 @@ static void decode_tmc_8A(struct rds_oda_data* data,
   data->tmc.group.extent = (blocks->c.val & C_TMC_EXTENT) >> 11;
   data->tmc.group.event = blocks->c.val & C_TMC_EVENT;
   data->tmc.group.location = blocks->d.val;
+
+  if (data->tmc.group.tuning)
+    return;
+  if (data->tmc.group.single_group)
+    decode_tmc_single_group(data);
+  else
+    decode_tmc_multi_group(data, blocks);
 }
 
 /**
  * Decode the RTL-TMC data as per ISO 14819-1.
  */
 static void decode_tmc(struct rds_oda_data* data,
+                       void* state,
+                       const struct rds_data* rds,
                        const struct rds_blocks* blocks,
                        struct rds_group_type gt) {
+  UNUSED(state);
+  UNUSED(rds);
   if (gt.code == 8 && gt.version == 'A') {
     decode_tmc_8A(data, blocks);
   } else if (gt.code == 3 && gt.version == 'A') {
@@ -205,8 +893,157 @@ static void decode_tmc(struct rds_oda_data* data,
   }
 }
 
-static void decode_itunes(struct rds_oda_data* data) {
-  UNUSED(data);
+static void clear_rt_plus(struct rds_oda_data* data, void* state) {
+  UNUSED(state);
+  clear_tags(&data->rtplus);
+  // Completed items (and |count|) are kept so history readers' cursors remain
+  // valid. The running item is dropped.
+  data->rtplus_history.have_bits = false;
+  memset(&data->rtplus_history.current, 0,
+         sizeof(data->rtplus_history.current));
+}
+
+static void clear_tmc(struct rds_oda_data* data, void* state) {
+  UNUSED(state);
+  const struct tmc_location_index* locations = data->tmc.locations;
+  memset(&data->tmc, 0, sizeof(data->tmc));
+  data->tmc.locations = locations;
+}
+
+/**
+ * Decode iTunes tagging. The tags use the RT+ group layout (and content types)
+ * and likewise reference the RadioText rather than copying it.
+ */
+static void decode_itunes(struct rds_oda_data* data,
+                          void* state,
+                          const struct rds_data* rds,
+                          const struct rds_blocks* blocks,
+                          struct rds_group_type gt) {
+  UNUSED(state);
+  UNUSED(gt);
+  decode_rt_tags(&data->itunes, rds, blocks);
+}
+
+static void clear_itunes(struct rds_oda_data* data, void* state) {
+  UNUSED(state);
+  clear_tags(&data->itunes);
+}
+
+/**
+ * The decoders registered by create_oda_data().
+ */
+static const struct oda_decoder kBuiltinDecoders[] = {
+    {AID_RT_PLUS, decode_rt_plus, clear_rt_plus, 0},
+    {AID_TMC, decode_tmc, clear_tmc, 0},
+    {AID_ITUNES, decode_itunes, clear_itunes, 0},
+};
+
+static uint8_t get_slot_index(uint32_t seed, uint16_t app_id) {
+  return (uint32_t)(app_id * seed) >> (32 - ODA_SLOT_BITS);
+}
+
+/**
+ * Get the slot for |app_id|, or NULL if no decoder is registered for it.
+ */
+static struct oda_decoder_slot* find_slot(const struct rds_oda_data* oda_data,
+                                          uint16_t app_id) {
+  const struct oda_decoder_slot* slot =
+      &oda_data->registry.slot[get_slot_index(oda_data->registry.seed, app_id)];
+  if (!slot->decoder || slot->decoder->app_id != app_id)
+    return NULL;
+  return (struct oda_decoder_slot*)slot;
+}
+
+/**
+ * Does |seed| hash every registered AID, and |app_id|, to a different slot?
+ */
+static bool is_perfect_seed(const struct rds_oda_data* oda_data,
+                            uint32_t seed,
+                            uint16_t app_id) {
+  uint32_t used = UINT32_C(1) << get_slot_index(seed, app_id);
+  for (size_t i = 0; i < ARRAY_SIZE(oda_data->registry.slot); i++) {
+    const struct oda_decoder* decoder = oda_data->registry.slot[i].decoder;
+    if (!decoder)
+      continue;
+    const uint32_t bit = UINT32_C(1) << get_slot_index(seed, decoder->app_id);
+    if (used & bit)
+      return false;
+    used |= bit;
+  }
+  return true;
+}
+
+static void* get_slot_state(struct rds_oda_data* oda_data,
+                            const struct oda_decoder_slot* slot) {
+  if (!slot->decoder->state_size)
+    return NULL;
+  return (uint8_t*)oda_data->registry.pool + slot->state_offset;
+}
+
+bool register_oda_decoder(struct rds_oda_data* oda_data,
+                          const struct oda_decoder* decoder) {
+  if (!decoder->app_id || oda_data->registry.count == ODA_MAX_DECODERS)
+    return false;
+  if (find_slot(oda_data, decoder->app_id))
+    return false;
+  // Keep every state block 8-byte aligned.
+  const size_t state_size = (decoder->state_size + 7u) & ~(size_t)7u;
+  if (state_size >
+      (size_t)(ODA_STATE_POOL_SIZE - oda_data->registry.pool_used)) {
+    return false;
+  }
+
+  uint32_t seed =
+      oda_data->registry.seed ? oda_data->registry.seed : ODA_INITIAL_SEED;
+  int tries = 0;
+  while (!is_perfect_seed(oda_data, seed, decoder->app_id)) {
+    if (++tries == ODA_MAX_SEED_TRIES)
+      return false;
+    seed = (seed * 1664525u + 1013904223u) | 1u;  // Next odd multiplier.
+  }
+
+  // Rehash the existing decoders with the new seed.
+  struct oda_decoder_slot slots[ARRAY_SIZE(oda_data->registry.slot)];
+  memset(slots, 0, sizeof(slots));
+  for (size_t i = 0; i < ARRAY_SIZE(slots); i++) {
+    const struct oda_decoder_slot* slot = &oda_data->registry.slot[i];
+    if (slot->decoder)
+      slots[get_slot_index(seed, slot->decoder->app_id)] = *slot;
+  }
+  struct oda_decoder_slot* slot = &slots[get_slot_index(seed, decoder->app_id)];
+  slot->decoder = decoder;
+  slot->state_offset = oda_data->registry.pool_used;
+  memcpy(oda_data->registry.slot, slots, sizeof(slots));
+  oda_data->registry.seed = seed;
+  oda_data->registry.count++;
+  oda_data->registry.pool_used += state_size;
+
+  void* state = get_slot_state(oda_data, slot);
+  if (state)
+    memset(state, 0, decoder->state_size);
+  return true;
+}
+
+void* get_oda_decoder_state(struct rds_oda_data* oda_data, uint16_t app_id) {
+  const struct oda_decoder_slot* slot = find_slot(oda_data, app_id);
+  return slot ? get_slot_state(oda_data, slot) : NULL;
+}
+
+uint32_t get_oda_packet_count(const struct rds_oda_data* oda_data,
+                              uint16_t app_id) {
+  const struct oda_decoder_slot* slot = find_slot(oda_data, app_id);
+  return slot ? slot->pkt_count : 0;
+}
+
+struct rds_oda_data* create_oda_data() {
+  struct rds_oda_data* oda_data =
+      (struct rds_oda_data*)calloc(1, sizeof(struct rds_oda_data));
+  if (!oda_data)
+    return NULL;
+  oda_data->registry.seed = ODA_INITIAL_SEED;
+  for (size_t i = 0; i < ARRAY_SIZE(kBuiltinDecoders); i++)
+    register_oda_decoder(oda_data, &kBuiltinDecoders[i]);
+  return oda_data;
 }
 
 void decode_oda_blocks(struct rds_oda_data* oda_data,
@@ -214,43 +1051,163 @@ void decode_oda_blocks(struct rds_oda_data* oda_data,
                        const struct rds_data* rds,
                        const struct rds_blocks* blocks,
                        struct rds_group_type gt) {
-  switch (app_id) {
-    case AID_RT_PLUS:
-      oda_data->stats.rtplus_cnt++;
-      decode_rt_plus(oda_data, rds, blocks);
-      break;
-    case AID_TMC:
-      oda_data->stats.tmc_cnt++;
-      decode_tmc(oda_data, blocks, gt);
-      break;
-    case AID_ITUNES:
-      oda_data->stats.itunes_cnt++;
-      decode_itunes(oda_data);
-      break;
-    case 0x0:
-      break;
+  struct oda_decoder_slot* slot = find_slot(oda_data, app_id);
+  if (!slot)
+    return;
+  slot->pkt_count++;
+  slot->decoder->decode(oda_data, get_slot_state(oda_data, slot), rds, blocks,
+                        gt);
+}
+
+size_t decode_oda_batch(struct rds_oda_data* oda_data,
+                        const struct rds_data* rds,
+                        const struct oda_group* groups,
+                        size_t count,
+                        uint32_t* scratch) {
+  // Chain each slot's groups, in order, through |scratch|: scratch[i] is the
+  // index of the next group for the same slot as groups[i]. This finds each
+  // group's slot once, and groups without a registered decoder are left out.
+  enum { kNumSlots = 1 << ODA_SLOT_BITS };
+  uint32_t head[kNumSlots];
+  uint32_t tail[kNumSlots];
+  uint32_t group_cnt[kNumSlots] = {0};
+  for (size_t i = 0; i < count; i++) {
+    const struct oda_decoder_slot* slot = find_slot(oda_data, groups[i].app_id);
+    if (!slot)
+      continue;
+    const size_t b = slot - oda_data->registry.slot;
+    if (group_cnt[b]++)
+      scratch[tail[b]] = i;
+    else
+      head[b] = i;
+    tail[b] = i;
+  }
+
+  size_t decoded = 0;
+  for (uint8_t b = 0; b < kNumSlots; b++) {
+    if (!group_cnt[b])
+      continue;
+    struct oda_decoder_slot* slot = &oda_data->registry.slot[b];
+    const oda_decode_fn decode = slot->decoder->decode;
+    void* state = get_slot_state(oda_data, slot);
+    slot->pkt_count += group_cnt[b];
+    uint32_t i = head[b];
+    for (uint32_t n = group_cnt[b]; n; n--) {
+      decode(oda_data, state, rds, &groups[i].blocks, groups[i].gt);
+      if (n > 1)
+        i = scratch[i];
+    }
+    decoded += group_cnt[b];
   }
+  return decoded;
 }
 
 void clear_oda_data(struct rds_oda_data* oda_data) {
-  memset(oda_data, 0, sizeof(*oda_data));
+  for (size_t i = 0; i < ARRAY_SIZE(oda_data->registry.slot); i++) {
+    struct oda_decoder_slot* slot = &oda_data->registry.slot[i];
+    if (!slot->decoder)
+      continue;
+    slot->pkt_count = 0;
+    void* state = get_slot_state(oda_data, slot);
+    if (slot->decoder->clear)
+      slot->decoder->clear(oda_data, state);
+    else if (state)
+      memset(state, 0, slot->decoder->state_size);
+  }
+}
+
+/**
+ * The registered ODA Application IDs (RDS Forum R17/032), sorted by AID so
+ * that find_app_name() can binary search them. oda_names_test checks that
+ * every entry is found, so update its count when adding AIDs.
+ */
+static const struct aid_name {
+  uint16_t app_id;
+  char name[48];  ///< Inline (not a pointer) so the table needs no relocation.
+} kAppNames[] = {
+    {0x0093, "Cross referencing DAB within RDS"},
+    {0x0BCB, "Leisure & Practical Info for Drivers"},
+    {0x0C24, "ELECTRABEL-DSM 7"},
+    {0x0CC1, "Wireless Playground broadcast control signal"},
+    {0x0D45, "RDS-TMC: ALERT-C / EN ISO 14819-1 (test)"},
+    {0x0D8B, "ELECTRABEL-DSM 18"},
+    {0x0E2C, "ELECTRABEL-DSM 3"},
+    {0x0E31, "ELECTRABEL-DSM 13"},
+    {0x0F87, "ELECTRABEL-DSM 2"},
+    {0x125F, "I-FM-RDS for fixed and mobile devices"},
+    {0x1BDA, "ELECTRABEL-DSM 1"},
+    {0x1C5E, "ELECTRABEL-DSM 20"},
+    {0x1C68, "ITIS In-vehicle data base"},
+    {0x1CB1, "ELECTRABEL-DSM 10"},
+    {0x1D47, "ELECTRABEL-DSM 4"},
+    {0x1DC2, "CITIBUS 4"},
+    {0x1DC5, "Encrypted TTI using ALERT-Plus"},
+    {0x1E8F, "ELECTRABEL-DSM 17"},
+    {0x4400, "RDS-Light"},
+    {0x4AA1, "RASANT"},
+    {0x4AB7, "ELECTRABEL-DSM 9"},
+    {0x4BA2, "ELECTRABEL-DSM 5"},
+    {0x4BD7, "RadioText+ (RT+)"},
+    {0x4BD8, "RadioText+ for eRT"},
+    {0x4C59, "CITIBUS 2"},
+    {0x4D87, "Radio Commerce System (RCS)"},
+    {0x4D95, "ELECTRABEL-DSM 16"},
+    {0x4D9A, "ELECTRABEL-DSM 11"},
+    {0x50DD, "Disaster and emergency warning"},
+    {0x5757, "Personal weather station"},
+    {0x6363, "Hybradio RDS-Net (testing)"},
+    {0x6365, "RDS2 9 bit AF lists"},
+    {0x6552, "Enhanced RadioText (eRT)"},
+    {0x6A7A, "Warning receiver"},
+    {0x7373, "Enhanced early warning system"},
+    {0xA112, "NL Alert system"},
+    {0xA911, "Data FM Selective Multipoint Messaging"},
+    {0xC350, "NRSC Song Title and Artist"},
+    {0xC3A1, "Personal Radio Service"},
+    {0xC3B0, "iTunes Tagging"},
+    {0xC3C3, "NAVTEQ Traffic Plus"},
+    {0xC4D4, "eEAS"},
+    {0xC549, "Smart Grid Broadcast Channel"},
+    {0xC563, "ID Logic"},
+    {0xC6A7, "Veil Enabled Interactive Device"},
+    {0xC737, "Utility Message Channel (UMC)"},
+    {0xCB73, "CITIBUS 1"},
+    {0xCB97, "ELECTRABEL-DSM 14"},
+    {0xCC21, "CITIBUS 3"},
+    {0xCD46, "RDS-TMC: ALERT-C"},
+    {0xCD47, "RDS-TMC: ALERT-C"},
+    {0xCD9E, "ELECTRABEL-DSM 8"},
+    {0xCE6B, "Encrypted TTI using ALERT-Plus"},
+    {0xE123, "APS Gateway"},
+    {0xE1C1, "Action code"},
+    {0xE319, "ELECTRABEL-DSM 12"},
+    {0xE411, "Beacon downlink"},
+    {0xE440, "ELECTRABEL-DSM 15"},
+    {0xE4A6, "ELECTRABEL-DSM 19"},
+    {0xE5D7, "ELECTRABEL-DSM 6"},
+    {0xE911, "EAS open protocol"},
+    {0xFF7F, "RFT: Station logo"},
+    {0xFF80, "RFT+ (work title)"},
+};
+
+const char* find_app_name(uint16_t app_id) {
+  const struct aid_name* base = kAppNames;
+  size_t n = ARRAY_SIZE(kAppNames);
+  while (n > 1) {
+    const size_t half = n / 2;
+    base = base[half].app_id <= app_id ? base + half : base;
+    n -= half;
+  }
+  return base->app_id == app_id ? base->name : NULL;
 }
 
 void get_app_name(char* buffer, uint16_t buffer_len, uint16_t app_id) {
   if (buffer_len == 0)
     return;
-  switch (app_id) {
-    case AID_RT_PLUS:
-      strncpy(buffer, "RT+", buffer_len);
-      break;
-    case AID_TMC:
-      strncpy(buffer, "RDS-TMC", buffer_len);
-      break;
-    case AID_ITUNES:
-      strncpy(buffer, "iTunes", buffer_len);
-      break;
-    default:
-      snprintf(buffer, buffer_len, "0x%X", app_id);
-  }
+  const char* name = find_app_name(app_id);
+  if (name)
+    strncpy(buffer, name, buffer_len);
+  else
+    snprintf(buffer, buffer_len, "0x%X", app_id);
   buffer[buffer_len - 1] = '\0';
 }
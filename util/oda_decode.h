@@ -25,11 +25,224 @@
 extern "C" {
 #endif /* __cplusplus */
 
+// clang-format off
+//
+// http://www.rds.org.uk/2010/pdf/R17_032_1.pdf
+#define AID_RT_PLUS 0x4BD7 // Radiotext Plus (RT+).
+#define AID_TMC     0xCD46
+#define AID_ITUNES  0xC3B0 // iTunes tagging.
+
+// clang-format on
+
+/** log2 of the number of slots in the ODA decoder hash table. */
+#define ODA_SLOT_BITS 4
+
+/** The maximum number of registered ODA decoders. */
+#define ODA_MAX_DECODERS 8
+
+/** The size (in bytes) of the pool from which decoder state is allocated. */
+#define ODA_STATE_POOL_SIZE 256
+
+struct rds_oda_data;
+
+/**
+ * Decode a group for a registered ODA.
+ *
+ * |state| is the decoder's state block, or NULL if it has none.
+ */
+typedef void (*oda_decode_fn)(struct rds_oda_data* oda_data,
+                              void* state,
+                              const struct rds_data* rds,
+                              const struct rds_blocks* blocks,
+                              struct rds_group_type gt);
+
+/**
+ * Reset a registered ODA decoder to its initial state.
+ */
+typedef void (*oda_clear_fn)(struct rds_oda_data* oda_data, void* state);
+
+/**
+ * A decoder for one ODA application ID (AID). Instances are referenced, not
+ * copied, when registered so they must outlive the rds_oda_data (normally they
+ * are static const).
+ */
+struct oda_decoder {
+  uint16_t app_id;      ///< The ODA application ID (AID).
+  oda_decode_fn decode;  ///< Called for each group for |app_id|.
+  oda_clear_fn clear;   ///< Optional - if NULL the state is zeroed.
+  uint16_t state_size;  ///< Size of the (zero initialized) state block.
+};
+
+/**
+ * A slot in the ODA decoder hash table.
+ */
+struct oda_decoder_slot {
+  const struct oda_decoder* decoder;  ///< NULL if the slot is unused.
+  uint32_t pkt_count;                 ///< # of groups decoded.
+  uint16_t state_offset;              ///< Offset of state in the pool.
+};
+
+/** The maximum number of tags held by struct rds_oda_tags. */
+#define ODA_MAX_TAGS 8
+
+/**
+ * A tagged span of RadioText. The text itself isn't copied: it is |length|
+ * characters, starting at |start|, of the RadioText buffer (A or B) which was
+ * being decoded when the tag was received.
+ */
+struct rds_oda_tag {
+  uint8_t content_type;  ///< Content type (1..63).
+  uint8_t start;         ///< Index of the first character.
+  uint8_t length;        ///< Number of characters.
+  uint8_t rt;            ///< RadioText buffer: RT_A or RT_B.
+  uint16_t rt_gen;       ///< rds_oda_tags::rt_gen when received.
+};
+
+/**
+ * The currently active tags - at most one per content type.
+ *
+ * Only active tags are stored, so iterate over tag[0..count), which is sorted
+ * by content type.
+ */
+struct rds_oda_tags {
+  uint64_t active;   ///< Bit N is set if content type N has a tag.
+  uint64_t changed;  ///< Bit N is set if content type N changed since read.
+  uint16_t rt_gen;   ///< RadioText generation, incremented on each A/B flip.
+  uint8_t last_rt;   ///< The RadioText A/B flag when last decoded.
+  uint8_t count;     ///< Number of tags in |tag|.
+  struct rds_oda_tag tag[ODA_MAX_TAGS];
+};
+
+/**
+ * The number of completed RT+ items kept in struct rtplus_history (each is
+ * 140 bytes). This may be raised (for the whole build) by applications
+ * showing a longer play history.
+ */
+#if !defined(RTPLUS_HISTORY_SIZE)
+#define RTPLUS_HISTORY_SIZE 4
+#endif
+
+/** The maximum length of RT+ item text (the RadioText length). */
+#define RTPLUS_ITEM_TEXT_LEN 64
+
+/**
+ * An RT+ item (e.g. a song). Times are as given to set_oda_time().
+ */
+struct rtplus_item {
+  char title[RTPLUS_ITEM_TEXT_LEN + 1];   ///< ITEM.TITLE, or empty.
+  char artist[RTPLUS_ITEM_TEXT_LEN + 1];  ///< ITEM.ARTIST, or empty.
+  uint32_t started;  ///< Time the item started.
+  uint32_t ended;    ///< Time the item ended.
+};
+
+/**
+ * RT+ item tracking. Items are delimited by the item toggle and item running
+ * bits, and completed items are appended to a ring of the last
+ * RTPLUS_HISTORY_SIZE items. Read with get_next_rtplus_item().
+ */
+struct rtplus_history {
+  bool have_bits;     ///< |item_toggle| and |item_running| are valid.
+  bool item_toggle;   ///< The last item toggle bit.
+  bool item_running;  ///< The last item running bit.
+  struct rtplus_item current;  ///< The running item.
+  uint32_t count;  ///< # of items ever completed (sequence # of the next).
+  struct rtplus_item items[RTPLUS_HISTORY_SIZE];  ///< By sequence # % size.
+};
+
+/**
+ * The number of messages in the RDS-TMC message pool. This may be raised
+ * (for the whole build) by applications tracking many messages.
+ */
+#if !defined(TMC_MAX_MESSAGES)
+#define TMC_MAX_MESSAGES 32
+#endif
+
+/** The most locations one message affects: its own plus a 31 location extent. */
+#define TMC_MAX_MESSAGE_LOCATIONS 32
+
+/**
+ * The number of entries in the TMC location index. Every message's primary
+ * location is always indexed; extent locations use what remains, and are
+ * found by a scan of the message's extent once it is full. May be raised (for
+ * the whole build) up to TMC_MAX_MESSAGES * TMC_MAX_MESSAGE_LOCATIONS.
+ */
+#if !defined(TMC_MAX_LOCATION_REFS)
+#define TMC_MAX_LOCATION_REFS (TMC_MAX_MESSAGES * 4)
+#endif
+
+/** Max. free format bits in a multi-group message (4 groups of 28 bits). */
+#define TMC_MAX_FREE_FORMAT_BITS 112
+
+/**
+ * An RDS-TMC user message (ISO 14819-1), from either a single group or a
+ * reassembled multi-group sequence.
+ */
+struct tmc_message {
+  uint16_t event;     ///< Event code (ISO 14819-2).
+  uint16_t location;  ///< Location code (ISO 14819-3).
+  uint8_t extent;     ///< # of locations affected beyond |location|.
+  uint8_t duration;   ///< Duration and persistence (DP or label 0).
+  bool pos_dir;       ///< Positive direction (else negative direction).
+  bool diversion;     ///< Advised to follow indicated diversion.
+  bool multi_group;   ///< Reassembled from a multi-group sequence.
+  uint8_t urgency;    ///< enum tmc_urgency (from the event and labels).
+  bool has_quantifier;  ///< |quantifier| was given (labels 4 and 5).
+  uint8_t quantifier;   ///< See format_tmc_quantifier().
+  uint8_t free_format_bits;  ///< # of bits in |free_format|.
+  uint8_t free_format[TMC_MAX_FREE_FORMAT_BITS / 8];  ///< MSB first.
+  uint8_t location_cnt;  ///< # of locations affected (when indexed).
+  uint8_t indexed_cnt;   ///< # of those in the location index.
+  uint32_t received;  ///< Time first received (see set_oda_time()).
+  uint32_t updated;   ///< Time last received.
+  uint32_t expires;   ///< Time at which it is removed.
+};
+
+/**
+ * An entry in the location index of active TMC messages.
+ */
+struct tmc_location_ref {
+  uint16_t location;  ///< A location affected by the message.
+  uint16_t msg;       ///< Index into |tmc.messages|.
+};
+
+struct tmc_location_index;
+
+/**
+ * A multi-group TMC message being reassembled.
+ */
+struct tmc_assembly {
+  bool active;       ///< A first group has been received.
+  uint8_t next_gsi;  ///< Group sequence indicator expected next.
+  uint16_t first_c;  ///< Block C of the first group.
+  uint16_t first_d;  ///< Block D of the first group.
+  struct tmc_message msg;
+};
+
+/**
+ * A logged ODA group, for decode_oda_batch().
+ */
+struct oda_group {
+  struct rds_blocks blocks;
+  struct rds_group_type gt;
+  uint16_t app_id;
+};
+
 struct rds_oda_data {
+  uint32_t now;                ///< Current time - see set_oda_time().
+  struct rds_oda_tags rtplus;  ///< Radiotext Plus (AKA RT+).
+  struct rtplus_history rtplus_history;  ///< RT+ items.
+  struct rds_oda_tags itunes;  ///< iTunes tagging.
   struct {
-    char text[65][64];  ///< 65 64-bit text strings.
-  } rtplus;             ///< Radiotext Plus (AKA RT+).
-  struct {
+    uint16_t message_cnt;  ///< # of messages in |messages|.
+    struct tmc_message messages[TMC_MAX_MESSAGES];  ///< Active messages.
+    /// Location table used to find the locations in a message's extent.
+    const struct tmc_location_index* locations;
+    uint8_t ltn;  ///< The last Location Table Number received, or 0.
+    uint32_t location_ref_cnt;  ///< # of entries in |location_refs|.
+    uint32_t extent_ref_cnt;    ///< # of those which are extent locations.
+    /// Locations affected by active messages, sorted by location.
+    struct tmc_location_ref location_refs[TMC_MAX_LOCATION_REFS];
+    struct tmc_assembly assembly[8];  ///< Indexed by continuity index.
     struct {
       bool tuning;        ///< Tuning information (or reserved for future use).
       bool single_group;  ///< true=single group, false=multi-group.
@@ -65,10 +278,17 @@ struct rds_oda_data {
     } system;           ///< RDS-TMS System messages.
   } tmc;                ///< RDS-TMC messages.
   struct {
-    uint16_t rtplus_cnt;  ///< # of RT+ groups processed.
-    uint16_t tmc_cnt;     ///< # of RDS-TMC groups processed.
-    uint16_t itunes_cnt;  ///< # of iTunes groups processed.
-  } stats;                ///< ODA statistics.
+    /**
+     * Decoders, perfectly hashed by AID: every registered AID maps (using
+     * |seed|) to its own slot, so dispatch is a single probe no matter how
+     * many decoders are registered.
+     */
+    struct oda_decoder_slot slot[1 << ODA_SLOT_BITS];
+    uint32_t seed;       ///< The hash multiplier.
+    uint8_t count;       ///< # of registered decoders.
+    uint16_t pool_used;  ///< # of bytes of |pool| allocated.
+    uint64_t pool[ODA_STATE_POOL_SIZE / sizeof(uint64_t)];  ///< State blocks.
+  } registry;  ///< Registered ODA decoders.
 };
 
 /**
@@ -76,6 +296,28 @@ struct rds_oda_data {
  */
 struct rds_oda_data* create_oda_data();
 
+/**
+ * Register a decoder for an additional ODA. The RT+, RDS-TMC, and iTunes
+ * decoders are registered by create_oda_data().
+ *
+ * Returns false if the AID is already registered, or there is no space for
+ * the decoder or its state.
+ */
+bool register_oda_decoder(struct rds_oda_data* oda_data,
+                          const struct oda_decoder* decoder);
+
+/**
+ * Get the state block for the decoder registered for |app_id|. Returns NULL
+ * if there is no such decoder, or it has no state.
+ */
+void* get_oda_decoder_state(struct rds_oda_data* oda_data, uint16_t app_id);
+
+/**
+ * Get the number of groups decoded for |app_id| since the last clear.
+ */
+uint32_t get_oda_packet_count(const struct rds_oda_data* oda_data,
+                              uint16_t app_id);
+
 /**
  * Delete the oda_data item.
  */
@@ -96,7 +338,86 @@ void decode_oda_blocks(struct rds_oda_data* oda_data,
                        struct rds_group_type gt);
 
 /**
- * Get a user displayable representation for app_id.
+ * Decode |count| logged groups a decoder at a time: each registered decoder
+ * runs over all of its groups, in their original order, in one loop. Groups
+ * for different ODAs may be decoded in a different order than they were
+ * logged.
+ *
+ * Every group is decoded against the same |rds|, not the RDS data current
+ * when it was received, so the RadioText which RT+ and iTunes tags index
+ * should not change during the batch. Groups whose AID has no registered
+ * decoder are skipped, and don't count towards any decoder's packet count.
+ *
+ * |scratch| must hold |count| entries. Returns the number of groups decoded.
+ */
+size_t decode_oda_batch(struct rds_oda_data* oda_data,
+                        const struct rds_data* rds,
+                        const struct oda_group* groups,
+                        size_t count,
+                        uint32_t* scratch);
+
+/**
+ * Set the current time, in seconds (any epoch), used to timestamp RT+ items
+ * and to timestamp and expire RDS-TMC messages. Expired messages are removed.
+ */
+void set_oda_time(struct rds_oda_data* oda_data, uint32_t now);
+
+/**
+ * Get the completed RT+ item with sequence number |*cursor| and advance the
+ * cursor. Start with a cursor of zero. Returns NULL once the cursor has
+ * caught up. Items which have been overwritten in the ring are skipped.
+ */
+const struct rtplus_item* get_next_rtplus_item(
+    const struct rds_oda_data* oda_data,
+    uint32_t* cursor);
+
+/**
+ * Set the location table used to find all locations affected by a TMC
+ * message. Without one only a message's primary location is indexed. The
+ * table for the Location Table Number broadcast by the station is used.
+ */
+void set_tmc_location_index(struct rds_oda_data* oda_data,
+                            const struct tmc_location_index* locations);
+
+/**
+ * Find the active TMC messages affecting |location|, either at their
+ * primary location or within their extent. Up to |max_messages| are
+ * written to |messages|. Returns the total number of matching messages.
+ */
+size_t find_tmc_messages(const struct rds_oda_data* oda_data,
+                         uint16_t location,
+                         const struct tmc_message** messages,
+                         size_t max_messages);
+
+/**
+ * Find the tag for |content_type|. Returns NULL if there is none.
+ */
+const struct rds_oda_tag* find_oda_tag(const struct rds_oda_tags* tags,
+                                       uint8_t content_type);
+
+/**
+ * Get the content types whose tag was added, changed, or removed since the
+ * last call (as a bitmask - bit N for content type N), and reset them.
+ */
+uint64_t consume_oda_tag_changes(struct rds_oda_tags* tags);
+
+/**
+ * Get the text of |tag| from the RadioText in |rds|, which should be the
+ * latest RDS data. This returns a pointer into |rds| (no copy is made), which
+ * is *not* NUL terminated. The number of characters is written to |len|.
+ */
+const char* get_oda_tag_text(const struct rds_oda_tag* tag,
+                             const struct rds_data* rds,
+                             size_t* len);
+
+/**
+ * Get the registered name of |app_id|, or NULL if it is not registered.
+ */
+const char* find_app_name(uint16_t app_id);
+
+/**
+ * Get a user displayable representation for app_id: the registered name or,
+ * if unregistered, the AID in hex.
  */
 void get_app_name(char* buffer, uint16_t buffer_len, uint16_t app_id);
 
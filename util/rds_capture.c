@@ -0,0 +1,308 @@
+/**
+ * @file
+ *
+ * @author Chris Mumford
+ *
+ * @license
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "rds_capture.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/** The largest block error count (BLER 3: 6+, uncorrectable). */
+#define MAX_ERRORS 3
+
+struct rds_capture {
+  const uint8_t* base;  ///< The mapped file.
+  size_t size;          ///< The size of the mapping.
+  const struct rds_capture_header* header;
+  const uint8_t* records;  ///< header->record_size bytes each.
+  const uint32_t* index;   ///< NULL unless timed.
+};
+
+struct rds_capture_writer {
+  FILE* file;
+  struct rds_capture_header header;
+  uint32_t* index;      ///< The index entries written so far.
+  uint32_t index_size;  ///< The allocated size of |index|.
+  uint32_t last_time;   ///< The time of the last group written.
+  bool failed;          ///< A write has failed.
+};
+
+static bool in_file(size_t file_size, uint64_t offset, uint64_t len) {
+  return offset <= file_size && len <= file_size - offset;
+}
+
+/** The time of |group| in a timed capture. */
+static uint32_t get_record_time_at(const struct rds_capture* capture,
+                                   size_t group) {
+  return ((const struct rds_capture_record*)capture->records)[group].time;
+}
+
+/** Check the header. The records and index are not read. */
+static bool load_header(struct rds_capture* capture) {
+  if (capture->size < sizeof(struct rds_capture_header))
+    return false;
+  const struct rds_capture_header* header =
+      (const struct rds_capture_header*)capture->base;
+  const bool timed = header->flags & RDS_CAPTURE_TIMED;
+  const uint64_t num_index =
+      timed && header->index_interval
+          ? ((uint64_t)header->num_groups + header->index_interval - 1) /
+                header->index_interval
+          : 0;
+  const bool valid_record_size =
+      header->record_size == sizeof(struct rds_capture_record) ||
+      (!timed && header->record_size == sizeof(struct rds_capture_group));
+  if (header->magic != RDS_CAPTURE_MAGIC ||
+      header->version != RDS_CAPTURE_VERSION || !valid_record_size ||
+      header->file_size != capture->size ||
+      (timed && !header->index_interval) || header->num_index != num_index ||
+      header->index_offset % sizeof(uint32_t) ||
+      !in_file(capture->size, sizeof(*header),
+               (uint64_t)header->num_groups * header->record_size) ||
+      !in_file(capture->size, header->index_offset,
+               num_index * sizeof(uint32_t))) {
+    return false;
+  }
+  capture->header = header;
+  capture->records = (const uint8_t*)(header + 1);
+  if (timed)
+    capture->index = (const uint32_t*)(capture->base + header->index_offset);
+  return true;
+}
+
+struct rds_capture* open_rds_capture(const char* fname) {
+  const int fd = open(fname, O_RDONLY);
+  if (fd == -1)
+    return NULL;
+  struct stat sb;
+  if (fstat(fd, &sb) == -1 || sb.st_size <= 0) {
+    close(fd);
+    return NULL;
+  }
+  void* base = mmap(NULL, sb.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED)
+    return NULL;
+
+  struct rds_capture* capture =
+      (struct rds_capture*)calloc(1, sizeof(struct rds_capture));
+  if (!capture) {
+    munmap(base, sb.st_size);
+    return NULL;
+  }
+  capture->base = (const uint8_t*)base;
+  capture->size = sb.st_size;
+  if (!load_header(capture)) {
+    close_rds_capture(capture);
+    return NULL;
+  }
+  return capture;
+}
+
+void close_rds_capture(struct rds_capture* capture) {
+  if (!capture)
+    return;
+  munmap((void*)capture->base, capture->size);
+  free(capture);
+}
+
+size_t get_rds_capture_num_groups(const struct rds_capture* capture) {
+  return capture->header->num_groups;
+}
+
+bool get_rds_capture_start_time(const struct rds_capture* capture,
+                                int64_t* start_time) {
+  if (!capture->index)
+    return false;
+  *start_time = capture->header->start_time;
+  return true;
+}
+
+size_t read_rds_capture_blocks(const struct rds_capture* capture,
+                               size_t first,
+                               struct rds_blocks* blocks,
+                               size_t count) {
+  const size_t num_groups = capture->header->num_groups;
+  if (first >= num_groups)
+    return 0;
+  if (count > num_groups - first)
+    count = num_groups - first;
+  const size_t record_size = capture->header->record_size;
+  const uint8_t* pos = capture->records + first * record_size;
+  for (size_t i = 0; i < count; i++, pos += record_size) {
+    const struct rds_capture_group* rec = (const struct rds_capture_group*)pos;
+    blocks[i].a.val = rec->blocks[0];
+    blocks[i].a.errors = rec->errors & 0x3;
+    blocks[i].b.val = rec->blocks[1];
+    blocks[i].b.errors = (rec->errors >> 2) & 0x3;
+    blocks[i].c.val = rec->blocks[2];
+    blocks[i].c.errors = (rec->errors >> 4) & 0x3;
+    blocks[i].d.val = rec->blocks[3];
+    blocks[i].d.errors = rec->errors >> 6;
+  }
+  return count;
+}
+
+bool get_rds_capture_time(const struct rds_capture* capture,
+                          size_t group,
+                          uint32_t* time) {
+  if (!capture->index || group >= capture->header->num_groups)
+    return false;
+  *time = get_record_time_at(capture, group);
+  return true;
+}
+
+bool find_rds_capture_group(const struct rds_capture* capture,
+                            uint32_t time,
+                            size_t* group) {
+  if (!capture->index)
+    return false;
+  // Find the first index entry at or after |time|. The group is then in the
+  // interval before it.
+  size_t lo = 0;
+  size_t hi = capture->header->num_index;
+  while (lo < hi) {
+    const size_t mid = lo + (hi - lo) / 2;
+    if (capture->index[mid] < time)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  if (lo == 0) {
+    *group = 0;
+    return true;
+  }
+  const size_t interval = capture->header->index_interval;
+  size_t g = (lo - 1) * interval;
+  const size_t end = lo * interval < capture->header->num_groups
+                         ? lo * interval
+                         : capture->header->num_groups;
+  while (g < end && get_record_time_at(capture, g) < time)
+    g++;
+  *group = g;
+  return true;
+}
+
+struct rds_capture_writer* create_rds_capture_writer(const char* fname,
+                                                     bool timed) {
+  struct rds_capture_writer* writer = (struct rds_capture_writer*)calloc(
+      1, sizeof(struct rds_capture_writer));
+  if (!writer)
+    return NULL;
+  writer->file = fopen(fname, "wb");
+  if (!writer->file) {
+    free(writer);
+    return NULL;
+  }
+  writer->header.magic = RDS_CAPTURE_MAGIC;
+  writer->header.version = RDS_CAPTURE_VERSION;
+  writer->header.flags = timed ? RDS_CAPTURE_TIMED : 0;
+  writer->header.record_size = timed ? sizeof(struct rds_capture_record)
+                                     : sizeof(struct rds_capture_group);
+  writer->header.index_interval = RDS_CAPTURE_INDEX_INTERVAL;
+  // The header is rewritten once the counts are known.
+  if (fwrite(&writer->header, sizeof(writer->header), 1, writer->file) != 1)
+    writer->failed = true;
+  return writer;
+}
+
+static uint8_t get_errors(const struct rds_block* block) {
+  return block->errors < MAX_ERRORS ? block->errors : MAX_ERRORS;
+}
+
+/** Convert |time| to ms after the start time, never going backwards. */
+static uint32_t get_record_time(struct rds_capture_writer* writer,
+                                int64_t time) {
+  if (!writer->header.num_groups)
+    writer->header.start_time = time;
+  const int64_t offset = time - writer->header.start_time;
+  if (offset <= writer->last_time)
+    return writer->last_time;
+  writer->last_time = offset < UINT32_MAX ? (uint32_t)offset : UINT32_MAX;
+  return writer->last_time;
+}
+
+static bool add_index_entry(struct rds_capture_writer* writer, uint32_t time) {
+  if (writer->header.num_index == writer->index_size) {
+    const uint32_t size = writer->index_size ? writer->index_size * 2 : 64;
+    uint32_t* index =
+        (uint32_t*)realloc(writer->index, size * sizeof(uint32_t));
+    if (!index)
+      return false;
+    writer->index = index;
+    writer->index_size = size;
+  }
+  writer->index[writer->header.num_index++] = time;
+  return true;
+}
+
+bool write_rds_capture_group(struct rds_capture_writer* writer,
+                             const struct rds_blocks* blocks,
+                             int64_t time) {
+  if (writer->failed || writer->header.num_groups == UINT32_MAX)
+    return false;
+  struct rds_capture_record rec;
+  memset(&rec, 0, sizeof(rec));
+  rec.group.blocks[0] = blocks->a.val;
+  rec.group.blocks[1] = blocks->b.val;
+  rec.group.blocks[2] = blocks->c.val;
+  rec.group.blocks[3] = blocks->d.val;
+  rec.group.errors = get_errors(&blocks->a) | get_errors(&blocks->b) << 2 |
+               get_errors(&blocks->c) << 4 | get_errors(&blocks->d) << 6;
+  if (writer->header.flags & RDS_CAPTURE_TIMED) {
+    rec.time = get_record_time(writer, time);
+    if (writer->header.num_groups % writer->header.index_interval == 0 &&
+        !add_index_entry(writer, rec.time)) {
+      writer->failed = true;
+      return false;
+    }
+  }
+  // An untimed record is the leading group.
+  if (fwrite(&rec, writer->header.record_size, 1, writer->file) != 1) {
+    writer->failed = true;
+    return false;
+  }
+  writer->header.num_groups++;
+  return true;
+}
+
+bool close_rds_capture_writer(struct rds_capture_writer* writer) {
+  if (!writer)
+    return false;
+  struct rds_capture_header* header = &writer->header;
+  header->index_offset =
+      sizeof(*header) + (uint64_t)header->num_groups * header->record_size;
+  header->file_size =
+      header->index_offset + (uint64_t)header->num_index * sizeof(uint32_t);
+  bool ok = !writer->failed;
+  if (ok && header->num_index) {
+    ok = fwrite(writer->index, sizeof(uint32_t), header->num_index,
+                writer->file) == header->num_index;
+  }
+  // Written last, so an incomplete capture never has a valid header.
+  ok = ok && fseek(writer->file, 0, SEEK_SET) == 0 &&
+       fwrite(header, sizeof(*header), 1, writer->file) == 1;
+  if (fclose(writer->file) != 0)
+    ok = false;
+  free(writer->index);
+  free(writer);
+  return ok;
+}
@@ -0,0 +1,160 @@
+/**
+ * @file
+ *
+ * @author Chris Mumford
+ *
+ * @license
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <si470x.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * The binary RDS capture file format.
+ *
+ * A capture is a sequence of RDS groups, each a fixed size record, so group
+ * N is found without reading those before it. Captures are written by
+ * struct rds_capture_writer (e.g. by rds_capture_converter from an RDS Spy
+ * log) and used in place (memory mapped). As with the TMC location index,
+ * structures are naturally aligned and in the byte order of the host which
+ * wrote them, and a file of the wrong byte order fails the magic check.
+ *
+ *   struct rds_capture_header
+ *   struct rds_capture_record[num_groups]  (timed), or
+ *   struct rds_capture_group[num_groups]   (untimed)
+ *   uint32_t index[num_index]  (time of every index_interval'th group)
+ *
+ * The index is only present in timed captures, and is sparse: it holds the
+ * time of groups 0, index_interval, 2*index_interval, ... so that seeking to
+ * a time reads the (small) index and at most index_interval records.
+ */
+#define RDS_CAPTURE_MAGIC 0x43534452  // "RDSC"
+#define RDS_CAPTURE_VERSION 1
+
+/** The records hold times, relative to start_time. */
+#define RDS_CAPTURE_TIMED 0x0001
+
+/** The number of groups per index entry written by rds_capture_writer. */
+#define RDS_CAPTURE_INDEX_INTERVAL 1024
+
+struct rds_capture_header {
+  uint32_t magic;           ///< RDS_CAPTURE_MAGIC.
+  uint16_t version;         ///< RDS_CAPTURE_VERSION.
+  uint16_t flags;           ///< RDS_CAPTURE_TIMED, or 0.
+  uint32_t record_size;     ///< Record size: see struct rds_capture_group.
+  uint32_t index_interval;  ///< # of groups per index entry.
+  uint32_t num_groups;      ///< # of records.
+  uint32_t num_index;       ///< # of index entries.
+  int64_t start_time;       ///< Time of the first group (ms since the epoch).
+  uint64_t index_offset;    ///< File offset of the index.
+  uint64_t file_size;       ///< Total size of the file.
+};
+
+/**
+ * A group: the record of an untimed capture. Untimed captures may also use
+ * struct rds_capture_record, with a time of 0, as those written before this
+ * record was added do.
+ */
+struct rds_capture_group {
+  uint16_t blocks[4];  ///< Blocks A-D.
+  uint8_t errors;      ///< Block errors (0-3): A in bits 0-1 .. D in bits 6-7.
+  uint8_t reserved[3];
+};
+
+/** A group and its time: the record of a timed capture. */
+struct rds_capture_record {
+  struct rds_capture_group group;
+  uint32_t time;  ///< ms after start_time.
+};
+
+struct rds_capture;
+
+/**
+ * Map a capture file. Only the header is checked, so the time taken is
+ * independent of the size of the capture. Returns NULL on failure, or if
+ * the file is not a capture.
+ */
+struct rds_capture* open_rds_capture(const char* fname);
+
+void close_rds_capture(struct rds_capture* capture);
+
+size_t get_rds_capture_num_groups(const struct rds_capture* capture);
+
+/**
+ * Get the time (ms since the epoch) of the first group. Returns false if the
+ * capture is not timed.
+ */
+bool get_rds_capture_start_time(const struct rds_capture* capture,
+                                int64_t* start_time);
+
+/**
+ * Copy up to |count| groups, starting with group |first|, to |blocks|.
+ * Returns the number copied, which is less than |count| only at the end of
+ * the capture.
+ */
+size_t read_rds_capture_blocks(const struct rds_capture* capture,
+                               size_t first,
+                               struct rds_blocks* blocks,
+                               size_t count);
+
+/**
+ * Get the time of |group| (ms after the start time). Returns false if the
+ * capture is not timed or there is no such group.
+ */
+bool get_rds_capture_time(const struct rds_capture* capture,
+                          size_t group,
+                          uint32_t* time);
+
+/**
+ * Find the first group at or after |time| (ms after the start time). This
+ * is num_groups if every group is earlier. Returns false if the capture is
+ * not timed.
+ */
+bool find_rds_capture_group(const struct rds_capture* capture,
+                            uint32_t time,
+                            size_t* group);
+
+struct rds_capture_writer;
+
+/**
+ * Create a capture file, to which groups are appended as they are received.
+ * If |timed| the time of each group is also recorded. The file is not valid
+ * until close_rds_capture_writer(). Returns NULL on failure.
+ */
+struct rds_capture_writer* create_rds_capture_writer(const char* fname,
+                                                     bool timed);
+
+/**
+ * Append a group received at |time| (ms since the epoch, ignored unless the
+ * capture is timed). Times never go backwards: a group earlier than the one
+ * before it is given the same time.
+ */
+bool write_rds_capture_group(struct rds_capture_writer* writer,
+                             const struct rds_blocks* blocks,
+                             int64_t time);
+
+/**
+ * Write the index and header and close the capture. Returns false if any
+ * write failed, in which case the file is not a valid capture.
+ */
+bool close_rds_capture_writer(struct rds_capture_writer* writer);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,237 @@
+/**
+ * @file
+ *
+ * @author Chris Mumford
+ *
+ * @license
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "rds_spy_reader.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/** "XXXX XXXX XXXX XXXX": the shortest line holding a group. */
+#define GROUP_TEXT_LEN 19
+
+/** " @YYYY/MM/DD HH:MM:SS.cc": the timestamp following the group. */
+#define TIME_TEXT_LEN 24
+
+struct rds_spy_log {
+  const char* text;
+  size_t size;
+};
+
+/** Four "----" characters, as loaded by load_chars(). */
+#define MISSING_CHARS 0x2D2D2D2Du
+
+/** Load four characters, the first in the least significant byte. */
+static inline uint32_t load_chars(const char* p) {
+  const uint8_t* u = (const uint8_t*)p;
+  return (uint32_t)u[0] | (uint32_t)u[1] << 8 | (uint32_t)u[2] << 16 |
+         (uint32_t)u[3] << 24;
+}
+
+/**
+ * The high bit of each byte of |v| which is in the range [lo, hi]. Every
+ * byte of |v| must be < 0x80, so adding can't carry into the next byte.
+ */
+static inline uint32_t bytes_in_range(uint32_t v, uint8_t lo, uint8_t hi) {
+  const uint32_t ge_lo = v + 0x01010101u * (0x80u - lo);
+  const uint32_t gt_hi = v + 0x01010101u * (0x7Fu - hi);
+  return ge_lo & ~gt_hi & 0x80808080u;
+}
+
+/**
+ * Decode four hex characters (from load_chars()) into |val|, all four at
+ * once. Returns false if any is not a hex digit.
+ */
+static inline bool decode_hex4(uint32_t chars, uint16_t* val) {
+  if (chars & 0x80808080u)
+    return false;
+  const uint32_t digits = bytes_in_range(chars, '0', '9');
+  const uint32_t letters = bytes_in_range(chars | 0x20202020u, 'a', 'f');
+  if ((digits | letters) != 0x80808080u)
+    return false;
+  // '0'-'9' have a low nibble of 0-9, and 'A'-'F'/'a'-'f' 1-6 (+9 = 10-15).
+  const uint32_t nibbles = (chars & 0x0F0F0F0Fu) + (letters >> 7) * 9;
+  // Pair the nibbles into bytes: (n0 n1) in byte 0 and (n2 n3) in byte 2.
+  const uint32_t pairs = ((nibbles << 4) | (nibbles >> 8)) & 0x00FF00FFu;
+  *val = (uint16_t)((pairs & 0xFF) << 8 | pairs >> 16);
+  return true;
+}
+
+static inline bool decode_block(const char* p, struct rds_block* block) {
+  const uint32_t chars = load_chars(p);
+  if (decode_hex4(chars, &block->val)) {
+    block->errors = 0;
+    return true;
+  }
+  if (chars != MISSING_CHARS)
+    return false;
+  block->val = 0;
+  block->errors = RDS_SPY_MISSING_ERRORS;
+  return true;
+}
+
+/**
+ * Decode a line (without the newline) of |len| >= GROUP_TEXT_LEN chars. The
+ * blocks may be followed by anything after a space.
+ */
+static bool decode_line(const char* p, size_t len, struct rds_blocks* blocks) {
+  if (p[4] != ' ' || p[9] != ' ' || p[14] != ' ')
+    return false;
+  if (len > GROUP_TEXT_LEN && p[GROUP_TEXT_LEN] != ' ' &&
+      p[GROUP_TEXT_LEN] != '\r') {
+    return false;
+  }
+  return decode_block(p, &blocks->a) && decode_block(p + 5, &blocks->b) &&
+         decode_block(p + 10, &blocks->c) && decode_block(p + 15, &blocks->d);
+}
+
+struct rds_spy_log* open_rds_spy_log(const char* fname) {
+  const int fd = open(fname, O_RDONLY);
+  if (fd == -1)
+    return NULL;
+  struct stat sb;
+  if (fstat(fd, &sb) == -1 || sb.st_size <= 0) {
+    close(fd);
+    return NULL;
+  }
+  void* base = mmap(NULL, sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED)
+    return NULL;
+  // The log is read once, front to back.
+  posix_madvise(base, sb.st_size, POSIX_MADV_SEQUENTIAL);
+
+  struct rds_spy_log* log =
+      (struct rds_spy_log*)calloc(1, sizeof(struct rds_spy_log));
+  if (!log) {
+    munmap(base, sb.st_size);
+    return NULL;
+  }
+  log->text = (const char*)base;
+  log->size = sb.st_size;
+  return log;
+}
+
+void close_rds_spy_log(struct rds_spy_log* log) {
+  if (!log)
+    return;
+  munmap((void*)log->text, log->size);
+  free(log);
+}
+
+size_t get_rds_spy_log_size(const struct rds_spy_log* log) {
+  return log->size;
+}
+
+size_t get_rds_spy_log_max_groups(const struct rds_spy_log* log) {
+  size_t lines = 0;
+  const char* p = log->text;
+  const char* end = log->text + log->size;
+  while ((p = memchr(p, '\n', end - p)) != NULL) {
+    lines++;
+    p++;
+  }
+  // The last line need not be terminated.
+  return log->text[log->size - 1] == '\n' ? lines : lines + 1;
+}
+
+void init_rds_spy_cursor(const struct rds_spy_log* log,
+                         struct rds_spy_cursor* cursor) {
+  cursor->pos = log->text;
+  cursor->end = log->text + log->size;
+  cursor->group = NULL;
+  cursor->line = 0;
+}
+
+bool next_rds_spy_blocks(struct rds_spy_cursor* cursor,
+                         struct rds_blocks* blocks) {
+  while (cursor->pos < cursor->end) {
+    const char* line = cursor->pos;
+    const char* eol = memchr(line, '\n', cursor->end - line);
+    const size_t len = (eol ? eol : cursor->end) - line;
+    cursor->pos = eol ? eol + 1 : cursor->end;
+    cursor->line++;
+    if (len >= GROUP_TEXT_LEN && decode_line(line, len, blocks)) {
+      cursor->group = line;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Parse |len| decimal digits. Returns -1 if any character is not a digit.
+ */
+static int parse_digits(const char* p, int len) {
+  int val = 0;
+  for (int i = 0; i < len; i++) {
+    if (p[i] < '0' || p[i] > '9')
+      return -1;
+    val = val * 10 + (p[i] - '0');
+  }
+  return val;
+}
+
+/** The number of days from 1970-01-01 to |year|-|month|-|day|. */
+static int64_t days_from_civil(int year, int month, int day) {
+  // Count years from March, so that leap days are at the end of the year.
+  year -= month <= 2;
+  const int era = (year >= 0 ? year : year - 399) / 400;
+  const int yoe = year - era * 400;
+  const int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return (int64_t)era * 146097 + doe - 719468;
+}
+
+bool get_rds_spy_time(const struct rds_spy_cursor* cursor, int64_t* time) {
+  if (!cursor->group)
+    return false;
+  const char* p = cursor->group + GROUP_TEXT_LEN;
+  if (cursor->end - p < TIME_TEXT_LEN || p[0] != ' ' || p[1] != '@' ||
+      p[6] != '/' || p[9] != '/' || p[12] != ' ' || p[15] != ':' ||
+      p[18] != ':' || p[21] != '.') {
+    return false;
+  }
+  const int year = parse_digits(p + 2, 4);
+  const int month = parse_digits(p + 7, 2);
+  const int day = parse_digits(p + 10, 2);
+  const int hour = parse_digits(p + 13, 2);
+  const int minute = parse_digits(p + 16, 2);
+  const int second = parse_digits(p + 19, 2);
+  const int centisecond = parse_digits(p + 22, 2);
+  if (year < 0 || month < 1 || month > 12 || day < 1 || day > 31 ||
+      hour < 0 || hour > 23 || minute < 0 || minute > 59 || second < 0 ||
+      second > 60 || centisecond < 0) {
+    return false;
+  }
+  const int64_t secs = days_from_civil(year, month, day) * 86400 +
+                       hour * 3600 + minute * 60 + second;
+  *time = secs * 1000 + centisecond * 10;
+  return true;
+}
+
+size_t read_rds_spy_blocks(struct rds_spy_cursor* cursor,
+                           struct rds_blocks* blocks,
+                           size_t count) {
+  size_t n = 0;
+  while (n < count && next_rds_spy_blocks(cursor, &blocks[n]))
+    n++;
+  return n;
+}
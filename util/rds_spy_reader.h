@@ -0,0 +1,97 @@
+/**
+ * @file
+ *
+ * @author Chris Mumford
+ *
+ * @license
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <si470x.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * A memory mapped RDS Spy log. Each group is a line of four hexadecimal
+ * blocks, optionally followed by a timestamp:
+ *
+ *   3019 0408 E0CD 5745 @2013/10/25 13:04:14.07
+ *
+ * Blocks which were not received are written as "----". Lines which are not
+ * groups (e.g. the "<recorder=...>" header) are skipped.
+ */
+struct rds_spy_log;
+
+/** The block errors of a missing block (BLER 3: 6+, uncorrectable). */
+#define RDS_SPY_MISSING_ERRORS 3
+
+/**
+ * A forward iterator over the groups in a log. The text is decoded as it is
+ * read, so no more than one group is ever held in memory.
+ */
+struct rds_spy_cursor {
+  const char* pos;    ///< The start of the next line.
+  const char* end;    ///< The end of the mapped log.
+  const char* group;  ///< The line of the last group decoded.
+  uint32_t line;      ///< The number of lines read.
+};
+
+/**
+ * Map an RDS Spy log file. Returns NULL on failure, or if the file is empty.
+ */
+struct rds_spy_log* open_rds_spy_log(const char* fname);
+
+void close_rds_spy_log(struct rds_spy_log* log);
+
+/** The size (in bytes) of the log text. */
+size_t get_rds_spy_log_size(const struct rds_spy_log* log);
+
+/**
+ * An upper bound on the number of groups in the log (the number of lines),
+ * for callers which do want to size an array.
+ */
+size_t get_rds_spy_log_max_groups(const struct rds_spy_log* log);
+
+/** Position |cursor| at the first line of |log|. */
+void init_rds_spy_cursor(const struct rds_spy_log* log,
+                         struct rds_spy_cursor* cursor);
+
+/**
+ * Decode the next group into |blocks|. Returns false at the end of the log.
+ * Missing blocks are zero with RDS_SPY_MISSING_ERRORS errors.
+ */
+bool next_rds_spy_blocks(struct rds_spy_cursor* cursor,
+                         struct rds_blocks* blocks);
+
+/**
+ * Get the timestamp of the last group decoded, in ms since the epoch. The
+ * time is as written (usually local time). Returns false if the group has no
+ * timestamp. Timestamps are only parsed when asked for.
+ */
+bool get_rds_spy_time(const struct rds_spy_cursor* cursor, int64_t* time);
+
+/**
+ * Decode up to |count| groups into |blocks|, returning the number decoded.
+ * Fewer than |count| are only returned at the end of the log.
+ */
+size_t read_rds_spy_blocks(struct rds_spy_cursor* cursor,
+                           struct rds_blocks* blocks,
+                           size_t count);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
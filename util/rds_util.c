@@ -16,7 +16,13 @@
     (void)(expr);    \
   } while (0)
 
-const char* RTPlusCodeNames[65] = {
+/**
+ * RT+ content type names, indexed by content type.
+ *
+ * This is a two dimensional char array, rather than an array of pointers, so
+ * that the whole table is constant (flash) data with no relocations.
+ */
+static const char kRTPlusCodeNames[64][21] = {
     "Dummy",
     "Title",
     "Album",
@@ -78,6 +84,7 @@ const char* RTPlusCodeNames[65] = {
     "rfu",
     "rfu",
 
+    "Private classes",
     "Private classes",
     "Private classes",
 
@@ -87,6 +94,170 @@ const char* RTPlusCodeNames[65] = {
     "Purchase",
     "Get.data",
 };
+
+/**
+ * US/Canada/Mexico stations whose call sign is not derived from the PI code.
+ *
+ * Sorted by PI code so that it can be binary searched - keep it that way.
+ */
+#define CALL_SIGN(PI, NAME) \
+  { PI, sizeof(NAME) - 1, NAME }
+static const struct call_sign_US {
+  uint16_t pi_code;
+  uint8_t len;  ///< strlen(name).
+  char name[20];  ///< Inline (not a pointer) so the table needs no relocation.
+} kCallSignsUS[] = {
+    CALL_SIGN(941, "CKGE"),
+    CALL_SIGN(7760, "ZFKY (Cayman Is.)"),
+    CALL_SIGN(7877, "CFPL"),
+    CALL_SIGN(7908, "KTCZ"),
+    CALL_SIGN(8151, "ZFCC (Cayman Is.)"),
+    CALL_SIGN(12289, "KLAS (Jamaica)"),
+    CALL_SIGN(12656, "WAVW"),
+    CALL_SIGN(16416, "KSFW/CBLA"),
+    CALL_SIGN(17185, "CJPT"),
+    CALL_SIGN(25414, "WFNY/CFNY"),
+    CALL_SIGN(26428, "WHAY/CHAY"),
+    CALL_SIGN(26542, "WHFI/CHFI"),
+    CALL_SIGN(27382, "WILQ/CILQ"),
+    CALL_SIGN(27424, "WING/CING"),
+    CALL_SIGN(28378, "WJXY/CJXY"),
+    CALL_SIGN(34784, "XHTRR"),
+    CALL_SIGN(39248, "KEX"),
+    CALL_SIGN(39249, "KFH"),
+    CALL_SIGN(39250, "KFI/CJBC"),
+    CALL_SIGN(39251, "KGA/CBCx"),
+    CALL_SIGN(39252, "KGO/CBCP"),
+    CALL_SIGN(39253, "KGU"),
+    CALL_SIGN(39254, "KGW"),
+    CALL_SIGN(39255, "KGY"),
+    CALL_SIGN(39256, "KID"),
+    CALL_SIGN(39257, "KIT"),
+    CALL_SIGN(39258, "KJR"),
+    CALL_SIGN(39259, "KLO"),
+    CALL_SIGN(39260, "KLZ"),
+    CALL_SIGN(39261, "KMA"),
+    CALL_SIGN(39262, "KMJ"),
+    CALL_SIGN(39263, "KNX"),
+    CALL_SIGN(39264, "KOA"),
+    CALL_SIGN(39268, "KQV"),
+    CALL_SIGN(39269, "KSL"),
+    CALL_SIGN(39270, "KUJ"),
+    CALL_SIGN(39271, "KVI"),
+    CALL_SIGN(39272, "KWG"),
+    CALL_SIGN(39275, "KYW"),
+    CALL_SIGN(39277, "WBZ"),
+    CALL_SIGN(39278, "WDZ"),
+    CALL_SIGN(39279, "WEW"),
+    CALL_SIGN(39281, "WGL"),
+    CALL_SIGN(39282, "WGN"),
+    CALL_SIGN(39283, "WGR"),
+    CALL_SIGN(39285, "WHA"),
+    CALL_SIGN(39286, "WHB"),
+    CALL_SIGN(39287, "WHK"),
+    CALL_SIGN(39288, "WHO"),
+    CALL_SIGN(39290, "WIP"),
+    CALL_SIGN(39291, "WJR"),
+    CALL_SIGN(39292, "WKY"),
+    CALL_SIGN(39293, "WLS"),
+    CALL_SIGN(39294, "WLW"),
+    CALL_SIGN(39297, "WOC"),
+    CALL_SIGN(39299, "WOL"),
+    CALL_SIGN(39300, "WOR"),
+    CALL_SIGN(39304, "WWJ"),
+    CALL_SIGN(39305, "WWL"),
+    CALL_SIGN(39312, "KDB"),
+    CALL_SIGN(39313, "KGB"),
+    CALL_SIGN(39314, "KOY"),
+    CALL_SIGN(39315, "KPQ"),
+    CALL_SIGN(39316, "KSD"),
+    CALL_SIGN(39317, "KUT"),
+    CALL_SIGN(39318, "KXL"),
+    CALL_SIGN(39319, "KXO"),
+    CALL_SIGN(39321, "WBT"),
+    CALL_SIGN(39322, "WGH"),
+    CALL_SIGN(39323, "WGY"),
+    CALL_SIGN(39324, "WHP"),
+    CALL_SIGN(39325, "WIL"),
+    CALL_SIGN(39326, "WMC"),
+    CALL_SIGN(39327, "WMT"),
+    CALL_SIGN(39328, "WOI"),
+    CALL_SIGN(39329, "WOW"),
+    CALL_SIGN(39330, "WRR"),
+    CALL_SIGN(39331, "WSB"),
+    CALL_SIGN(39332, "WSM"),
+    CALL_SIGN(39333, "KBW"),  // Also XHSR?
+    CALL_SIGN(39334, "KCY"),
+    CALL_SIGN(39335, "KDF"),
+    CALL_SIGN(39338, "KHQ"),
+    CALL_SIGN(39339, "KOB"),
+    CALL_SIGN(39347, "WIS"),
+    CALL_SIGN(39348, "WJW"),
+    CALL_SIGN(39349, "WJZ"),
+    CALL_SIGN(39353, "WRC"),
+    CALL_SIGN(42149, "KSKZ or KWKR"),
+    CALL_SIGN(45084, "CIQM"),
+    CALL_SIGN(45313, "XHCTO"),
+    CALL_SIGN(49158, "CBCK"),
+    CALL_SIGN(49160, "CJBC-1"),
+    CALL_SIGN(49829, "CIMF"),
+    CALL_SIGN(51806, "CHNI, CJNI, or CKNI"),
+    CALL_SIGN(52007, "CBLJ"),
+    CALL_SIGN(52009, "CBEB"),
+    CALL_SIGN(52010, "CBLG"),
+    CALL_SIGN(52012, "CBQT"),
+    CALL_SIGN(52033, "CBA-FM"),
+    CALL_SIGN(52034, "CBCT"),
+    CALL_SIGN(52045, "CBHM"),
+};
+#undef CALL_SIGN
+
+/**
+ * Undo the RBDS PI code remapping of nationally/regionally linked stations.
+ */
+static uint16_t normalize_pi_US(uint16_t picode) {
+  if ((picode & 0xAF00) == 0xAF00)
+    picode = (picode & 0x00FF) << 8;
+  if ((picode & 0xA000) == 0xA000)
+    picode = ((picode & 0x0F00) << 4) | (picode & 0xFF);
+  return picode;
+}
+
+/**
+ * Is the call sign algorithmically encoded in |picode| (after normalization)?
+ */
+static bool is_derived_pi_US(uint16_t picode) {
+  return picode > 4095 && picode < 39247;
+}
+
+/**
+ * Binary search kCallSignsUS for a normalized PI code.
+ *
+ * The loop body is branch free (a conditional move) so that the cost is a
+ * fixed log2(N) iterations regardless of the PI code.
+ */
+static const char* find_call_sign_US(uint16_t picode, size_t* len) {
+  const struct call_sign_US* base = kCallSignsUS;
+  size_t n = ARRAY_SIZE(kCallSignsUS);
+  while (n > 1) {
+    const size_t half = n / 2;
+    base = base[half].pi_code <= picode ? base + half : base;
+    n -= half;
+  }
+  if (base->pi_code != picode)
+    return NULL;
+  if (len)
+    *len = base->len;
+  return base->name;
+}
+
+const char* get_pi_call_sign_US(uint16_t pi_code, size_t* len) {
+  pi_code = normalize_pi_US(pi_code);
+  if (is_derived_pi_US(pi_code))
+    return NULL;
+  return find_call_sign_US(pi_code, len);
+}
+
 /**
  * Decode the PI (Program Identification) code with RDSA for the US region.
  *
@@ -99,12 +270,9 @@ static bool decode_pi_US(char* buffer, size_t buffer_len, uint16_t picode) {
   if (buffer_len < 5)
     return false;
 
-  if ((picode & 0xAF00) == 0xAF00)
-    picode = (picode & 0x00FF) << 8;
-  if ((picode & 0xA000) == 0xA000)
-    picode = ((picode & 0x0F00) << 4) | (picode & 0xFF);
+  picode = normalize_pi_US(picode);
 
-  if (picode > 4095 && picode < 39247) {
+  if (is_derived_pi_US(picode)) {
     if (picode > 21671) {
       buffer[0] = 'W';
       picode -= 21672;
@@ -124,413 +292,345 @@ static bool decode_pi_US(char* buffer, size_t buffer_len, uint16_t picode) {
     return true;
   }
 
-  switch (picode) {
-    case 49829:
-      strncpy(buffer, "CIMF", buffer_len);
-      break;
-    case 17185:
-      strncpy(buffer, "CJPT", buffer_len);
-      break;
-    case 39248:
-      strncpy(buffer, "KEX", buffer_len);
-      break;
-    case 39249:
-      strncpy(buffer, "KFH", buffer_len);
-      break;
-    case 39253:
-      strncpy(buffer, "KGU", buffer_len);
-      break;
-    case 39254:
-      strncpy(buffer, "KGW", buffer_len);
-      break;
-    case 39255:
-      strncpy(buffer, "KGY", buffer_len);
-      break;
-    case 39256:
-      strncpy(buffer, "KID", buffer_len);
-      break;
-    case 39257:
-      strncpy(buffer, "KIT", buffer_len);
-      break;
-    case 39258:
-      strncpy(buffer, "KJR", buffer_len);
-      break;
-    case 39259:
-      strncpy(buffer, "KLO", buffer_len);
-      break;
-    case 39260:
-      strncpy(buffer, "KLZ", buffer_len);
-      break;
-    case 39261:
-      strncpy(buffer, "KMA", buffer_len);
-      break;
-    case 39262:
-      strncpy(buffer, "KMJ", buffer_len);
-      break;
-    case 39263:
-      strncpy(buffer, "KNX", buffer_len);
-      break;
-    case 39264:
-      strncpy(buffer, "KOA", buffer_len);
-      break;
-    case 39268:
-      strncpy(buffer, "KQV", buffer_len);
-      break;
-    case 39269:
-      strncpy(buffer, "KSL", buffer_len);
-      break;
-    case 39270:
-      strncpy(buffer, "KUJ", buffer_len);
-      break;
-    case 39271:
-      strncpy(buffer, "KVI", buffer_len);
-      break;
-    case 39272:
-      strncpy(buffer, "KWG", buffer_len);
-      break;
-    case 39275:
-      strncpy(buffer, "KYW", buffer_len);
-      break;
-    case 39277:
-      strncpy(buffer, "WBZ", buffer_len);
-      break;
-    case 39278:
-      strncpy(buffer, "WDZ", buffer_len);
-      break;
-    case 39279:
-      strncpy(buffer, "WEW", buffer_len);
-      break;
-    case 39281:
-      strncpy(buffer, "WGL", buffer_len);
-      break;
-    case 39282:
-      strncpy(buffer, "WGN", buffer_len);
-      break;
-    case 39283:
-      strncpy(buffer, "WGR", buffer_len);
-      break;
-    case 39285:
-      strncpy(buffer, "WHA", buffer_len);
-      break;
-    case 39286:
-      strncpy(buffer, "WHB", buffer_len);
-      break;
-    case 39287:
-      strncpy(buffer, "WHK", buffer_len);
-      break;
-    case 39288:
-      strncpy(buffer, "WHO", buffer_len);
-      break;
-    case 39290:
-      strncpy(buffer, "WIP", buffer_len);
-      break;
-    case 39291:
-      strncpy(buffer, "WJR", buffer_len);
-      break;
-    case 39292:
-      strncpy(buffer, "WKY", buffer_len);
-      break;
-    case 39293:
-      strncpy(buffer, "WLS", buffer_len);
-      break;
-    case 39294:
-      strncpy(buffer, "WLW", buffer_len);
-      break;
-    case 39297:
-      strncpy(buffer, "WOC", buffer_len);
-      break;
-    case 39299:
-      strncpy(buffer, "WOL", buffer_len);
-      break;
-    case 39300:
-      strncpy(buffer, "WOR", buffer_len);
-      break;
-    case 39304:
-      strncpy(buffer, "WWJ", buffer_len);
-      break;
-    case 39305:
-      strncpy(buffer, "WWL", buffer_len);
-      break;
-    case 39312:
-      strncpy(buffer, "KDB", buffer_len);
-      break;
-    case 39313:
-      strncpy(buffer, "KGB", buffer_len);
-      break;
-    case 39314:
-      strncpy(buffer, "KOY", buffer_len);
-      break;
-    case 39315:
-      strncpy(buffer, "KPQ", buffer_len);
-      break;
-    case 39316:
-      strncpy(buffer, "KSD", buffer_len);
-      break;
-    case 39317:
-      strncpy(buffer, "KUT", buffer_len);
-      break;
-    case 39318:
-      strncpy(buffer, "KXL", buffer_len);
-      break;
-    case 39319:
-      strncpy(buffer, "KXO", buffer_len);
-      break;
-    case 39321:
-      strncpy(buffer, "WBT", buffer_len);
-      break;
-    case 39322:
-      strncpy(buffer, "WGH", buffer_len);
-      break;
-    case 39323:
-      strncpy(buffer, "WGY", buffer_len);
-      break;
-    case 39324:
-      strncpy(buffer, "WHP", buffer_len);
-      break;
-    case 39325:
-      strncpy(buffer, "WIL", buffer_len);
-      break;
-    case 39326:
-      strncpy(buffer, "WMC", buffer_len);
-      break;
-    case 39327:
-      strncpy(buffer, "WMT", buffer_len);
-      break;
-    case 39328:
-      strncpy(buffer, "WOI", buffer_len);
-      break;
-    case 39329:
-      strncpy(buffer, "WOW", buffer_len);
-      break;
-    case 39330:
-      strncpy(buffer, "WRR", buffer_len);
-      break;
-    case 39331:
-      strncpy(buffer, "WSB", buffer_len);
-      break;
-    case 39332:
-      strncpy(buffer, "WSM", buffer_len);
-      break;
-    case 39333:  // Also XHSR?
-      strncpy(buffer, "KBW", buffer_len);
-      break;
-    case 39334:
-      strncpy(buffer, "KCY", buffer_len);
-      break;
-    case 39335:
-      strncpy(buffer, "KDF", buffer_len);
-      break;
-    case 39338:
-      strncpy(buffer, "KHQ", buffer_len);
-      break;
-    case 39339:
-      strncpy(buffer, "KOB", buffer_len);
-      break;
-    case 39347:
-      strncpy(buffer, "WIS", buffer_len);
-      break;
-    case 39348:
-      strncpy(buffer, "WJW", buffer_len);
-      break;
-    case 39349:
-      strncpy(buffer, "WJZ", buffer_len);
-      break;
-    case 39353:
-      strncpy(buffer, "WRC", buffer_len);
-      break;
-    case 26542:
-      strncpy(buffer, "WHFI/CHFI", buffer_len);
-      break;
-    case 39250:
-      strncpy(buffer, "KFI/CJBC", buffer_len);
-      break;
-    case 49160:
-      strncpy(buffer, "CJBC-1", buffer_len);
-      break;
-    case 49158:
-      strncpy(buffer, "CBCK", buffer_len);
-      break;
-    case 52010:
-      strncpy(buffer, "CBLG", buffer_len);
-      break;
-    case 52007:
-      strncpy(buffer, "CBLJ", buffer_len);
-      break;
-    case 52012:
-      strncpy(buffer, "CBQT", buffer_len);
-      break;
-    case 52009:
-      strncpy(buffer, "CBEB", buffer_len);
-      break;
-    case 28378:
-      strncpy(buffer, "WJXY/CJXY", buffer_len);
-      break;
-    case 39251:
-      strncpy(buffer, "KGA/CBCx", buffer_len);
-      break;
-    case 39252:
-      strncpy(buffer, "KGO/CBCP", buffer_len);
-      break;
-    case 941:
-      strncpy(buffer, "CKGE", buffer_len);
-      break;
-    case 16416:
-      strncpy(buffer, "KSFW/CBLA", buffer_len);
-      break;
-    case 25414:
-      strncpy(buffer, "WFNY/CFNY", buffer_len);
-      break;
-    case 27382:
-      strncpy(buffer, "WILQ/CILQ", buffer_len);
-      break;
-    case 27424:
-      strncpy(buffer, "WING/CING", buffer_len);
-      break;
-    case 26428:
-      strncpy(buffer, "WHAY/CHAY", buffer_len);
-      break;
-    case 52033:
-      strncpy(buffer, "CBA-FM", buffer_len);
-      break;
-    case 52034:
-      strncpy(buffer, "CBCT", buffer_len);
-      break;
-    case 52045:
-      strncpy(buffer, "CBHM", buffer_len);
-      break;
-    case 45084:
-      strncpy(buffer, "CIQM", buffer_len);
-      break;
-    case 51806:
-      strncpy(buffer, "CHNI, CJNI, or CKNI", buffer_len);
-      break;
-    case 12289:
-      strncpy(buffer, "KLAS (Jamaica)", buffer_len);
-      break;
-    case 7877:
-      strncpy(buffer, "CFPL", buffer_len);
-      break;
-    case 7760:
-      strncpy(buffer, "ZFKY (Cayman Is.)", buffer_len);
-      break;
-    case 8151:
-      strncpy(buffer, "ZFCC (Cayman Is.)", buffer_len);
-      break;
-    case 12656:
-      strncpy(buffer, "WAVW", buffer_len);
-      break;
-    case 7908:
-      strncpy(buffer, "KTCZ", buffer_len);
-      break;
-    case 42149:
-      strncpy(buffer, "KSKZ or KWKR", buffer_len);
-      break;
-    case 45313:
-      strncpy(buffer, "XHCTO", buffer_len);
-      break;
-    case 34784:
-      strncpy(buffer, "XHTRR", buffer_len);
-      break;
-    default:
-      return false;
-  }
-  buffer[buffer_len - 1] = '\0';
+  size_t len;
+  const char* call_sign = find_call_sign_US(picode, &len);
+  if (!call_sign)
+    return false;
+  if (len > buffer_len - 1)
+    len = buffer_len - 1;
+  memcpy(buffer, call_sign, len);
+  buffer[len] = '\0';
   return true;
 }
 
+/**
+ * Countries for the European extended country codes (ECC 0xE0-0xE4), indexed
+ * by [ECC - 0xE0][PI country code]. Values are ISO 3166-1 alpha-2 codes, and
+ * an empty string is an unallocated code.
+ *
+ * See IEC 62106 Annex D.
+ */
+#define ECC_EUROPE_FIRST 0xE0
+#define ECC_EUROPE_LAST 0xE4
+static const char kEuropeCountries[ECC_EUROPE_LAST - ECC_EUROPE_FIRST + 1][16]
+                                  [3] = {
+    // clang-format off
+    /* E0 */ {"", "DE", "DZ", "AD", "IL", "IT", "BE", "RU",
+              "PS", "AL", "AT", "HU", "MT", "DE", "", "EG"},
+    /* E1 */ {"", "GR", "CY", "SM", "CH", "JO", "FI", "LU",
+              "BG", "DK", "GI", "IQ", "GB", "LY", "RO", "FR"},
+    /* E2 */ {"", "MA", "CZ", "PL", "VA", "SK", "SY", "TN",
+              "", "LI", "IS", "MC", "LT", "RS", "ES", "NO"},
+    /* E3 */ {"", "ME", "IE", "TR", "MK", "", "", "",
+              "NL", "LV", "LB", "AZ", "HR", "KZ", "SE", "BY"},
+    /* E4 */ {"", "MD", "EE", "KG", "", "", "UA", "XK",
+              "PT", "SI", "AM", "UZ", "GE", "", "TM", "BA"},
+    // clang-format on
+};
+
+/**
+ * Names of the PI area coverage codes (PI bits 8-11).
+ */
+static const char kPICoverageNames[16][15] = {
+    "Local",       "International", "National",    "Supra-regional",
+    "Regional 1",  "Regional 2",    "Regional 3",  "Regional 4",
+    "Regional 5",  "Regional 6",    "Regional 7",  "Regional 8",
+    "Regional 9",  "Regional 10",   "Regional 11", "Regional 12",
+};
+
+const char* get_pi_country_code(uint16_t pi_code, uint8_t ecc) {
+  if (ecc < ECC_EUROPE_FIRST || ecc > ECC_EUROPE_LAST)
+    return NULL;
+  const char* country = kEuropeCountries[ecc - ECC_EUROPE_FIRST][pi_code >> 12];
+  return country[0] ? country : NULL;
+}
+
+/**
+ * Append |str| to |buffer| (of which |pos| chars are used), truncating as
+ * necessary, and return the new length. |buffer| is always NUL terminated.
+ */
+static size_t append_str(char* buffer,
+                         size_t buffer_len,
+                         size_t pos,
+                         const char* str) {
+  while (*str && pos < buffer_len - 1)
+    buffer[pos++] = *str++;
+  buffer[pos] = '\0';
+  return pos;
+}
+
 /**
  * Decode the RDS PI data for non US ("rest of world").
+ *
+ * The result is "<country> <coverage> #<program reference>", for example
+ * "DE Supra-regional #2A". If the country cannot be determined (ECC not yet
+ * received, or not a European ECC) the PI country code is shown in brackets
+ * ("[D]").
  */
-static bool decode_pi_ROW(char* buffer, size_t buffer_len, uint16_t pi_code) {
-  UNUSED(buffer);
-  UNUSED(buffer_len);
-  UNUSED(pi_code);
-  // TODO: Implement PI Code decoding for ROW.
-  return false;
+static bool decode_pi_ROW(char* buffer,
+                          size_t buffer_len,
+                          uint16_t pi_code,
+                          uint8_t ecc) {
+  static const char kHex[] = "0123456789ABCDEF";
+
+  if (buffer_len == 0 || pi_code == 0)
+    return false;
+
+  size_t pos = 0;
+  const char* country = get_pi_country_code(pi_code, ecc);
+  if (country) {
+    pos = append_str(buffer, buffer_len, pos, country);
+  } else {
+    const char unknown[] = {'[', kHex[pi_code >> 12], ']', '\0'};
+    pos = append_str(buffer, buffer_len, pos, unknown);
+  }
+  pos = append_str(buffer, buffer_len, pos, " ");
+  pos = append_str(buffer, buffer_len, pos,
+                   kPICoverageNames[(pi_code >> 8) & 0xF]);
+  const char ref[] = {' ', '#', kHex[(pi_code >> 4) & 0xF], kHex[pi_code & 0xF],
+                      '\0'};
+  append_str(buffer, buffer_len, pos, ref);
+  return true;
 }
 
 bool decode_pi_code(char* buffer,
                     size_t buffer_len,
                     uint16_t pi_code,
                     enum si470x_region_t region) {
+  return decode_pi_code_ecc(buffer, buffer_len, pi_code, /*ecc=*/0, region);
+}
+
+bool decode_pi_code_ecc(char* buffer,
+                        size_t buffer_len,
+                        uint16_t pi_code,
+                        uint8_t ecc,
+                        enum si470x_region_t region) {
   if (region == REGION_US)
     return decode_pi_US(buffer, buffer_len, pi_code);
   else
-    return decode_pi_ROW(buffer, buffer_len, pi_code);
+    return decode_pi_ROW(buffer, buffer_len, pi_code, ecc);
+}
+
+/**
+ * Combine the inputs of decode_pi_code_ecc() into a single cache key.
+ */
+static uint32_t make_pi_cache_key(uint16_t pi_code,
+                                  uint8_t ecc,
+                                  enum si470x_region_t region) {
+  return ((uint32_t)(uint8_t)region << 24) | ((uint32_t)ecc << 16) | pi_code;
+}
+
+const char* decode_pi_code_cached(struct pi_decode_cache* cache,
+                                  uint16_t pi_code,
+                                  uint8_t ecc,
+                                  enum si470x_region_t region) {
+  const uint32_t key = make_pi_cache_key(pi_code, ecc, region);
+  if (cache->count && cache->entry[0].key == key) {
+    cache->hits++;
+    return cache->entry[0].text;
+  }
+
+  // Find the entry (or the least recently used one if not cached), and move
+  // it to the front.
+  uint8_t idx = 1;
+  while (idx < cache->count && cache->entry[idx].key != key)
+    idx++;
+  const bool found = idx < cache->count;
+  if (found) {
+    cache->hits++;
+  } else {
+    cache->misses++;
+    if (cache->count < PI_CACHE_SIZE)
+      cache->count++;
+    idx = cache->count - 1;
+  }
+  if (idx) {
+    char tmp[sizeof(cache->entry[0])];
+    memcpy(tmp, &cache->entry[idx], sizeof(tmp));
+    memmove(&cache->entry[1], &cache->entry[0], idx * sizeof(cache->entry[0]));
+    memcpy(&cache->entry[0], tmp, sizeof(tmp));
+  }
+  if (!found) {
+    cache->entry[0].key = key;
+    if (!decode_pi_code_ecc(cache->entry[0].text,
+                            ARRAY_SIZE(cache->entry[0].text), pi_code, ecc,
+                            region)) {
+      cache->entry[0].text[0] = '\0';
+    }
+  }
+  return cache->entry[0].text;
+}
+
+const char* decode_rds_pi_code_cached(struct pi_decode_cache* cache,
+                                      const struct rds_data* rds,
+                                      enum si470x_region_t region) {
+  if ((rds->valid_values & RDS_SLC) &&
+      rds->slc.variant_code == SLC_VARIANT_PAGING) {
+    cache->ecc_pi_code = rds->pi_code;
+    cache->ecc = rds->slc.data.paging.country_code;
+  }
+  const uint8_t ecc = cache->ecc_pi_code == rds->pi_code ? cache->ecc : 0;
+  return decode_pi_code_cached(cache, rds->pi_code, ecc, region);
+}
+
+void clear_pi_decode_cache(struct pi_decode_cache* cache) {
+  memset(cache, 0, sizeof(*cache));
 }
 
 const char* get_rdsplus_code_name(uint16_t code_id) {
-  if (code_id > ARRAY_SIZE(RTPlusCodeNames))
+  if (code_id >= ARRAY_SIZE(kRTPlusCodeNames))
     return "Unknown";
   else
-    return RTPlusCodeNames[code_id];
+    return kRTPlusCodeNames[code_id];
 }
 
-static const char* get_pty_code_name_US(uint8_t pty_code) {
-  switch (pty_code) {
-    case 0:
-      return "";
-    case 1:
-      return "News";
-    case 2:
-      return "Information";
-    case 3:
-      return "Sports";
-    case 4:
-      return "Talk";
-    case 5:
-      return "Rock";
-    case 6:
-      return "Classic Rock";
-    case 7:
-      return "Adult Hits";
-    case 8:
-      return "Soft Rock";
-    case 9:
-      return "Top 40";
-    case 10:
-      return "Country";
-    case 11:
-      return "Oldies";
-    case 12:
-      return "Soft";
-    case 13:
-      return "Nostalgia";
-    case 14:
-      return "Jazz";
-    case 15:
-      return "Classical";
-    case 16:
-      return "Rhythm and Blues";
-    case 17:
-      return "Soft Rhythm and Blues";
-    case 18:
-      return "Foreign Language";
-    case 19:
-      return "Religious Music";
-    case 20:
-      return "Religious Talk";
-    case 21:
-      return "Personality";
-    case 22:
-      return "Public";
-    case 23:
-      return "College";
-    case 29:
-      return "Weather";
-    case 30:
-      return "Emergency Test";
-    case 31:
-      return "Emergency";
-  }
-  return "[Reserved]";
+#if defined(RDS_UTIL_PTY_RBDS_ONLY) && defined(RDS_UTIL_PTY_RDS_ONLY)
+#error "Define at most one of RDS_UTIL_PTY_RBDS_ONLY and RDS_UTIL_PTY_RDS_ONLY."
+#endif
+
+#define NUM_PTY_CODES 32
+
+/**
+ * The long (16 char) and short (8 char) names for one set of PTY codes.
+ */
+struct pty_names {
+  char long_name[NUM_PTY_CODES][17];
+  char short_name[NUM_PTY_CODES][9];
+};
+
+#if !defined(RDS_UTIL_PTY_RDS_ONLY)
+/**
+ * US (RBDS) program type names - NRSC-4-B.
+ */
+static const struct pty_names kPtyNamesRBDS = {
+    .long_name =
+        {
+            "",
+            "News",
+            "Information",
+            "Sports",
+            "Talk",
+            "Rock",
+            "Classic Rock",
+            "Adult Hits",
+            "Soft Rock",
+            "Top 40",
+            "Country",
+            "Oldies",
+            "Soft",
+            "Nostalgia",
+            "Jazz",
+            "Classical",
+            "Rhythm and Blues",
+            "Soft R & B",
+            "Foreign Language",
+            "Religious Music",
+            "Religious Talk",
+            "Personality",
+            "Public",
+            "College",
+            "[Reserved]",
+            "[Reserved]",
+            "[Reserved]",
+            "[Reserved]",
+            "[Reserved]",
+            "Weather",
+            "Emergency Test",
+            "Emergency",
+        },
+    .short_name =
+        {
+            "",         "News",     "Inform",   "Sports",   "Talk",
+            "Rock",     "Cls Rock", "Adlt Hit", "Soft Rck", "Top 40",
+            "Country",  "Oldies",   "Soft",     "Nostalga", "Jazz",
+            "Classicl", "R & B",    "Soft R&B", "Language", "Rel Musc",
+            "Rel Talk", "Persnlty", "Public",   "College",  "Reserved",
+            "Reserved", "Reserved", "Reserved", "Reserved", "Weather",
+            "Test",     "ALERT!",
+        },
+};
+#endif  // !defined(RDS_UTIL_PTY_RDS_ONLY)
+
+#if !defined(RDS_UTIL_PTY_RBDS_ONLY)
+/**
+ * European (RDS) program type names - IEC 62106 Annex F.
+ */
+static const struct pty_names kPtyNamesRDS = {
+    .long_name =
+        {
+            "",
+            "News",
+            "Current Affairs",
+            "Information",
+            "Sport",
+            "Education",
+            "Drama",
+            "Culture",
+            "Science",
+            "Varied",
+            "Pop Music",
+            "Rock Music",
+            "Easy Listening",
+            "Light Classical",
+            "Serious Classics",
+            "Other Music",
+            "Weather",
+            "Finance",
+            "Children's Progs",
+            "Social Affairs",
+            "Religion",
+            "Phone In",
+            "Travel",
+            "Leisure",
+            "Jazz Music",
+            "Country Music",
+            "National Music",
+            "Oldies Music",
+            "Folk Music",
+            "Documentary",
+            "Alarm Test",
+            "Alarm - Alarm !",
+        },
+    .short_name =
+        {
+            "",         "News",     "Affairs",  "Info",     "Sport",
+            "Educate",  "Drama",    "Culture",  "Science",  "Varied",
+            "Pop M",    "Rock M",   "Easy M",   "Light M",  "Classics",
+            "Other M",  "Weather",  "Finance",  "Children", "Social",
+            "Religion", "Phone In", "Travel",   "Leisure",  "Jazz",
+            "Country",  "Nation M", "Oldies",   "Folk M",   "Document",
+            "TEST",     "Alarm !",
+        },
+};
+#endif  // !defined(RDS_UTIL_PTY_RBDS_ONLY)
+
+/**
+ * Get the PTY names for |region|. Builds which define RDS_UTIL_PTY_RBDS_ONLY
+ * or RDS_UTIL_PTY_RDS_ONLY only contain (and always return) that one set.
+ */
+static const struct pty_names* get_pty_names(enum si470x_region_t region) {
+#if defined(RDS_UTIL_PTY_RBDS_ONLY)
+  UNUSED(region);
+  return &kPtyNamesRBDS;
+#elif defined(RDS_UTIL_PTY_RDS_ONLY)
+  UNUSED(region);
+  return &kPtyNamesRDS;
+#else
+  return region == REGION_US ? &kPtyNamesRBDS : &kPtyNamesRDS;
+#endif
 }
 
 const char* get_pty_code_name(uint8_t pty_code, enum si470x_region_t region) {
-  if (region == REGION_US)
-    return get_pty_code_name_US(pty_code);
-  else
-    return "? PTY NAME";
+  if (pty_code >= NUM_PTY_CODES)
+    return "[Invalid]";
+  return get_pty_names(region)->long_name[pty_code];
+}
+
+const char* get_pty_code_short_name(uint8_t pty_code,
+                                    enum si470x_region_t region) {
+  if (pty_code >= NUM_PTY_CODES)
+    return "Invalid";
+  return get_pty_names(region)->short_name[pty_code];
 }
 
 const char* get_device_name(enum si470x_device_t device) {
@@ -567,17 +667,100 @@ static uint32_t get_mjd(const struct rds_data* rds) {
 /**
  * Convert Modified Julian Date (MJD) to Date.
  *
- * Adapted from description in Annex G (p. 104) of RDMS specification.
+ * Uses only integer arithmetic (no software emulated floating point on FPU-less
+ * targets). The algorithm counts days from 0000-03-01 so that the leap day is
+ * the last day of the (shifted) year - see Howard Hinnant's "chrono-Compatible
+ * Low-Level Date Algorithms". Exact over the full 17-bit MJD range, unlike the
+ * Annex G formula which is only valid from 1900-03-01 to 2100-02-28.
  */
-static void MJD2Date(int mjd, int* year, int* month, int* day) {
-  *year = (int)((mjd - 15078.2) / 365.25);
-  *month = (int)((mjd - 14956.1 - (int)(*year * 365.25)) / 30.6001);
-  *day = mjd - 14956 - (int)(*year * 365.25) - (int)(*month * 30.6001);
-  const int k = ((*month == 14) || (*month == 15)) ? 1 : 0;
-  *year += k;
-  *year += 1900;  // Spec says from 1900.
-  *month -= 1 + k * 12;
-};
+static void MJD2Date(uint32_t mjd, int* year, int* month, int* day) {
+  const uint32_t kDaysFrom0000_03_01ToMJDEpoch = 678881;  // To 1858-11-17.
+  const uint32_t kDaysPer400Years = 146097;
+
+  const uint32_t days = mjd + kDaysFrom0000_03_01ToMJDEpoch;
+  const uint32_t era = days / kDaysPer400Years;
+  const uint32_t doe = days - era * kDaysPer400Years;  // [0, 146096]
+  const uint32_t yoe =
+      (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;  // [0, 399]
+  const uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);  // [0, 365]
+  const uint32_t mp = (5 * doy + 2) / 153;  // [0, 11], March = 0.
+  *day = (int)(doy - (153 * mp + 2) / 5 + 1);
+  *month = (int)(mp < 10 ? mp + 3 : mp - 9);
+  *year = (int)(yoe + era * 400) + (*month <= 2);
+}
+
+/**
+ * Write |val| as a decimal number with at least |min_digits| digits (zero
+ * padded). Returns a pointer to the character following the last digit.
+ */
+static char* put_uint(char* p, unsigned val, int min_digits) {
+  char digits[10];
+  int n = 0;
+  do {
+    digits[n++] = '0' + val % 10;
+    val /= 10;
+  } while (val);
+  while (n < min_digits)
+    digits[n++] = '0';
+  while (n)
+    *p++ = digits[--n];
+  return p;
+}
+
+/**
+ * Get the local (MJD, minute of day) of the time in |rds|.
+ *
+ * The UTC offset is in (signed) multiples of 30 minutes.
+ */
+static void get_local_time(const struct rds_data* rds,
+                           uint32_t* mjd,
+                           uint16_t* minute_of_day) {
+  const int kMinutesPerDay = 24 * 60;
+
+  int32_t day = (int32_t)get_mjd(rds);
+  int minute = rds->clock.hour * 60 + rds->clock.minute +
+               rds->clock.utc_offset * 30;
+  if (minute >= kMinutesPerDay) {
+    minute -= kMinutesPerDay;
+    day++;
+  } else if (minute < 0) {
+    minute += kMinutesPerDay;
+    if (day > 0)
+      day--;
+  }
+  *mjd = (uint32_t)day;
+  *minute_of_day = (uint16_t)minute;
+}
+
+const char* format_local_time_cached(struct local_time_cache* cache,
+                                     const struct rds_data* rds) {
+  uint32_t mjd;
+  uint16_t minute;
+  get_local_time(rds, &mjd, &minute);
+
+  if (!cache->valid || cache->mjd != mjd) {
+    int year, month, day;
+    MJD2Date(mjd, &year, &month, &day);
+    char* p = put_uint(cache->text, month, 1);
+    *p++ = '/';
+    p = put_uint(p, day, 1);
+    *p++ = '/';
+    p = put_uint(p, year, 4);
+    *p++ = ' ';
+    cache->time_pos = p - cache->text;
+    cache->mjd = mjd;
+  } else if (cache->minute == minute) {
+    return cache->text;
+  }
+
+  char* p = put_uint(cache->text + cache->time_pos, minute / 60, 2);
+  *p++ = ':';
+  p = put_uint(p, minute % 60, 2);
+  *p = '\0';
+  cache->minute = minute;
+  cache->valid = true;
+  return cache->text;
+}
 
 void format_local_time(char* buff,
                        uint8_t bufflen,
@@ -585,25 +768,12 @@ void format_local_time(char* buff,
   if (!bufflen)
     return;
 
-  uint32_t mjd = get_mjd(rds);
-
-  // Use the UTF offset (# of 30 min. chunks) to convert UTC to local time.
-  int hour = rds->clock.hour;
-  int minute = rds->clock.minute;
-  // TODO: Properly handle odd offsets (e.g. 30 min., 90 min.).
-  int offset_hours = rds->clock.utc_offset / 2;
-  hour += offset_hours;
-  if (hour > 23) {
-    hour -= 24;
-    mjd++;
-  } else if (hour < 0) {
-    hour += 24;
-    mjd--;
-  }
-  int year, month, day;
-  MJD2Date(mjd, &year, &month, &day);
-
-  snprintf(buff, bufflen, "%d/%d/%04d %02d:%02d", month, day, year, hour,
-           minute);
-  buff[bufflen - 1] = '\0';
+  struct local_time_cache cache;
+  cache.valid = false;
+  const char* text = format_local_time_cached(&cache, rds);
+  size_t len = strlen(text);
+  if (len > (size_t)bufflen - 1)
+    len = bufflen - 1;
+  memcpy(buff, text, len);
+  buff[len] = '\0';
 }
@@ -36,6 +36,42 @@
 extern "C" {
 #endif /* __cplusplus */
 
+/** The number of PI codes remembered by struct pi_decode_cache. */
+#define PI_CACHE_SIZE 8
+
+/** The maximum length (with terminator) of a cached decoded PI code. */
+#define PI_CACHE_TEXT_LEN 24
+
+/**
+ * A cache of decoded PI codes, most recently used first. Entry zero is the
+ * currently tuned station, so the common case (an unchanged PI code) costs a
+ * single compare. A zero initialized cache is empty.
+ */
+struct pi_decode_cache {
+  struct {
+    uint32_t key;  ///< Region, ECC, and PI code - see make_pi_cache_key().
+    char text[PI_CACHE_TEXT_LEN];  ///< Empty if PI code can't be decoded.
+  } entry[PI_CACHE_SIZE];
+  uint8_t count;         ///< Number of valid entries.
+  uint32_t hits;         ///< # of lookups answered from the cache.
+  uint32_t misses;       ///< # of lookups which had to decode the PI code.
+  uint16_t ecc_pi_code;  ///< The PI code which |ecc| was received with.
+  uint8_t ecc;           ///< The last ECC received, or zero.
+};
+
+/**
+ * The last local time formatted by format_local_time_cached(). The date is
+ * only reformatted when the day changes, and the time when the minute changes.
+ * Set |valid| to false (or zero initialize) before first use.
+ */
+struct local_time_cache {
+  bool valid;        ///< |text| holds a formatted time.
+  uint32_t mjd;      ///< Local Modified Julian Date of |text|.
+  uint16_t minute;   ///< Local minute of the day of |text|.
+  uint8_t time_pos;  ///< Offset of the "HH:MM" part of |text|.
+  char text[24];     ///< "M/D/YYYY HH:MM".
+};
+
 /**
  * Decode the program identification code (pi_code) value into a displayable
  * string.
@@ -45,16 +81,93 @@ bool decode_pi_code(char* buffer,
                     uint16_t pi_code,
                     enum si470x_region_t region);
 
+/**
+ * Same as decode_pi_code(), but also uses the extended country code (ECC,
+ * received in group 1A variant 0) to identify the country outside the US.
+ * Pass zero for |ecc| if it has not been received.
+ */
+bool decode_pi_code_ecc(char* buffer,
+                        size_t buffer_len,
+                        uint16_t pi_code,
+                        uint8_t ecc,
+                        enum si470x_region_t region);
+
+/**
+ * Same as decode_pi_code_ecc(), but returns the result from |cache| if the PI
+ * code was recently decoded. Returns a string owned by |cache| which is valid
+ * until the next call, and is empty if the PI code could not be decoded.
+ */
+const char* decode_pi_code_cached(struct pi_decode_cache* cache,
+                                  uint16_t pi_code,
+                                  uint8_t ecc,
+                                  enum si470x_region_t region);
+
+/**
+ * Same as decode_pi_code_cached(), but takes the PI code and the extended
+ * country code (ECC) from |rds|. The ECC is only sent in group 1A variant 0,
+ * which alternates with the other variants, so the last ECC received for the
+ * PI code is remembered in |cache|.
+ */
+const char* decode_rds_pi_code_cached(struct pi_decode_cache* cache,
+                                      const struct rds_data* rds,
+                                      enum si470x_region_t region);
+
+/**
+ * Remove all entries from |cache| and reset the hit/miss counters.
+ */
+void clear_pi_decode_cache(struct pi_decode_cache* cache);
+
+/**
+ * Get the ISO 3166-1 alpha-2 country code for a (non US) PI code and extended
+ * country code. Returns NULL if the country is unknown.
+ */
+const char* get_pi_country_code(uint16_t pi_code, uint8_t ecc);
+
+/**
+ * Get the call sign of a US station whose PI code is in the call sign table
+ * (i.e. not algorithmically derived from the PI code).
+ *
+ * Returns a pointer to a constant, NUL terminated, string and sets |len| (if
+ * not NULL) to its length. No data is copied. Returns NULL if |pi_code| has no
+ * table entry - use decode_pi_code() for the derived K/W call signs.
+ */
+const char* get_pi_call_sign_US(uint16_t pi_code, size_t* len);
+
 const char* get_rdsplus_code_name(uint16_t code_id);
 
+/**
+ * Get the (up to 16 character) name of a program type (PTY) code. The US uses
+ * the RBDS names and all other regions the RDS names.
+ *
+ * Builds for a single region can define RDS_UTIL_PTY_RBDS_ONLY (US), or
+ * RDS_UTIL_PTY_RDS_ONLY (rest of world) so that only that set of names is
+ * compiled in. |region| is then ignored.
+ */
 const char* get_pty_code_name(uint8_t pty_code, enum si470x_region_t region);
 
+/**
+ * Same as get_pty_code_name(), but gets the (up to 8 character) short name.
+ */
+const char* get_pty_code_short_name(uint8_t pty_code,
+                                    enum si470x_region_t region);
+
 const char* get_device_name(enum si470x_device_t device);
 
 void get_manufacturer_name(uint16_t id, char* name, size_t name_len);
 
+/**
+ * Format the RDS clock time (CT), converted to local time, as
+ * "M/D/YYYY HH:MM".
+ */
 void format_local_time(char* buff, uint8_t bufflen, const struct rds_data* rds);
 
+/**
+ * Same as format_local_time(), but only reformats the parts of the time
+ * which changed since the last call. Returns a string owned by |cache|.
+ */
+const char* format_local_time_cached(struct local_time_cache* cache,
+                                     const struct rds_data* rds);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -0,0 +1,1036 @@
+// Generated by tmc_event_compiler from tmc_event_list.csv. Do not edit.
+//
+// Only included by tmc_events.c.
+
+// clang-format off
+
+/** The event texts. Index 0 is the empty string. */
+static const char kTMCEventTextData[] =
+    "\0"
+    "traffic problem\0"
+    "queuing traffic (with average speeds Q). Danger of stationary traffic\0"
+    "stationary traffic\0"
+    "stationary traffic for 1 km\0"
+    "stationary traffic for 2 km\0"
+    "stationary traffic for 4 km\0"
+    "stationary traffic for 6 km\0"
+    "stationary traffic for 10 km\0"
+    "stationary traffic expected\0"
+    "queuing traffic (with average speeds Q)\0"
+    "queuing traffic for 1 km (with average speeds Q)\0"
+    "queuing traffic for 2 km (with average speeds Q)\0"
+    "queuing traffic for 4 km (with average speeds Q)\0"
+    "queuing traffic for 6 km (with average speeds Q)\0"
+    "queuing traffic for 10 km (with average speeds Q)\0"
+    "queuing traffic expected\0"
+    "slow traffic (with average speeds Q)\0"
+    "slow traffic for 1 km (with average speeds Q)\0"
+    "slow traffic for 2 km (with average speeds Q)\0"
+    "slow traffic for 4 km (with average speeds Q)\0"
+    "slow traffic for 6 km (with average speeds Q)\0"
+    "slow traffic for 10 km (with average speeds Q)\0"
+    "slow traffic expected\0"
+    "heavy traffic (with average speeds Q)\0"
+    "heavy traffic expected\0"
+    "traffic flowing freely (with average speeds Q)\0"
+    "traffic building up (with average speeds Q)\0"
+    "no problems to report\0"
+    "traffic congestion cleared\0"
+    "message cancelled\0"
+    "stationary traffic for 3 km\0"
+    "danger of stationary traffic\0"
+    "queuing traffic for 3 km (with average speeds Q)\0"
+    "danger of queuing traffic (with average speeds Q)\0"
+    "long queues (with average speeds Q)\0"
+    "slow traffic for 3 km (with average speeds Q)\0"
+    "traffic easing\0"
+    "traffic congestion (with average speeds Q)\0"
+    "traffic lighter than normal (with average speeds Q)\0"
+    "queuing traffic (with average speeds Q). Approach with care\0"
+    "queuing traffic around a bend in the road\0"
+    "queuing traffic over the crest of a hill\0"
+    "all accidents cleared, no problems to report\0"
+    "traffic heavier than normal (with average speeds Q)\0"
+    "traffic very much heavier than normal (with average speeds Q)\0"
+    "accident(s)\0"
+    "serious accident(s)\0"
+    "multi-vehicle accident (involving Q vehicles)\0"
+    "accident involving (a/Q) heavy lorr(y/ies)\0"
+    "(Q) accident(s) involving hazardous materials\0"
+    "(Q) fuel spillage accident(s)\0"
+    "(Q) chemical spillage accident(s)\0"
+    "vehicles slowing to look at (Q) accident(s)\0"
+    "(Q) accident(s) in the opposing lanes\0"
+    "(Q) shed load(s)\0"
+    "(Q) broken down vehicle(s)\0"
+    "(Q) broken down heavy lorr(y/ies)\0"
+    "(Q) vehicle fire(s)\0"
+    "(Q) incident(s)\0"
+    "(Q) accident(s). Stationary traffic\0"
+    "(Q) accident(s). Stationary traffic for 1 km\0"
+    "(Q) accident(s). Stationary traffic for 2 km\0"
+    "(Q) accident(s). Stationary traffic for 4 km\0"
+    "(Q) accident(s). Stationary traffic for 6 km\0"
+    "(Q) accident(s). Stationary traffic for 10 km\0"
+    "(Q) accident(s). Danger of stationary traffic\0"
+    "(Q) accident(s). Queuing traffic\0"
+    "(Q) accident(s). Queuing traffic for 1 km\0"
+    "(Q) accident(s). Queuing traffic for 2 km\0"
+    "(Q) accident(s). Queuing traffic for 4 km\0"
+    "(Q) accident(s). Queuing traffic for 6 km\0"
+    "(Q) accident(s). Queuing traffic for 10 km\0"
+    "(Q) accident(s). Danger of queuing traffic\0"
+    "(Q) accident(s). Slow traffic\0"
+    "(Q) accident(s). Slow traffic for 1 km\0"
+    "(Q) accident(s). Slow traffic for 2 km\0"
+    "(Q) accident(s). Slow traffic for 4 km\0"
+    "(Q) accident(s). Slow traffic for 6 km\0"
+    "(Q) accident(s). Slow traffic for 10 km\0"
+    "(Q) accident(s). Slow traffic expected\0"
+    "(Q) accident(s). Heavy traffic\0"
+    "(Q) accident(s). Heavy traffic expected\0"
+    "(Q) accident(s). Traffic flowing freely\0"
+    "(Q) accident(s). Traffic building up\0"
+    "road closed due to (Q) accident(s)\0"
+    "(Q) accident(s). Right lane blocked\0"
+    "(Q) accident(s). Centre lane blocked\0"
+    "(Q) accident(s). Left lane blocked\0"
+    "(Q) accident(s). Hard shoulder blocked\0"
+    "(Q) accident(s). Two lanes blocked\0"
+    "(Q) accident(s). Three lanes blocked\0"
+    "accident. Delays (Q)\0"
+    "accident. Delays (Q) expected\0"
+    "accident. Long delays (Q)\0"
+    "vehicles slowing to look at (Q) accident(s). Stationary traffic\0"
+    "vehicles slowing to look at (Q) accident(s). Stationary traffic for 1 km\0"
+    "vehicles slowing to look at (Q) accident(s). Stationary traffic for 2 km\0"
+    "vehicles slowing to look at (Q) accident(s). Stationary traffic for 4 km\0"
+    "vehicles slowing to look at (Q) accident(s). Stationary traffic for 6 km\0"
+    "vehicles slowing to look at (Q) accident(s). Stationary traffic for 10 km\0"
+    "vehicles slowing to look at (Q) accident(s). Danger of stationary traffic\0"
+    "vehicles slowing to look at (Q) accident(s). Queuing traffic\0"
+    "vehicles slowing to look at (Q) accident(s). Queuing traffic for 1 km\0"
+    "vehicles slowing to look at (Q) accident(s). Queuing traffic for 2 km\0"
+    "vehicles slowing to look at (Q) accident(s). Queuing traffic for 4 km\0"
+    "vehicles slowing to look at (Q) accident(s). Queuing traffic for 6 km\0"
+    "vehicles slowing to look at (Q) accident(s). Queuing traffic for 10 km\0"
+    "vehicles slowing to look at (Q) accident(s). Danger of queuing traffic\0"
+    "vehicles slowing to look at (Q) accident(s). Slow traffic\0"
+    "vehicles slowing to look at (Q) accident(s). Slow traffic for 1 km\0"
+    "vehicles slowing to look at (Q) accident(s). Slow traffic for 2 km\0"
+    "vehicles slowing to look at (Q) accident(s). Slow traffic for 4 km\0"
+    "vehicles slowing to look at (Q) accident(s). Slow traffic for 6 km\0"
+    "vehicles slowing to look at (Q) accident(s). Slow traffic for 10 km\0"
+    "vehicles slowing to look at (Q) accident(s). Slow traffic expected\0"
+    "vehicles slowing to look at (Q) accident(s). Heavy traffic\0"
+    "vehicles slowing to look at (Q) accident(s). Heavy traffic expected\0"
+    "vehicles slowing to look at (Q) accident(s). Traffic building up\0"
+    "vehicles slowing to look at accident. Delays (Q)\0"
+    "vehicles slowing to look at accident. Delays (Q) expected\0"
+    "vehicles slowing to look at accident. Long delays (Q)\0"
+    "(Q) shed load(s). Stationary traffic\0"
+    "(Q) shed load(s). Stationary traffic for 1 km\0"
+    "(Q) shed load(s). Stationary traffic for 2 km\0"
+    "(Q) shed load(s). Stationary traffic for 4 km\0"
+    "(Q) shed load(s). Stationary traffic for 6 km\0"
+    "(Q) shed load(s). Stationary traffic for 10 km\0"
+    "(Q) shed load(s). Danger of stationary traffic\0"
+    "(Q) shed load(s). Queuing traffic\0"
+    "(Q) shed load(s). Queuing traffic for 1 km\0"
+    "(Q) shed load(s). Queuing traffic for 2 km\0"
+    "(Q) shed load(s). Queuing traffic for 4 km\0"
+    "(Q) shed load(s). Queuing traffic for 6 km\0"
+    "(Q) shed load(s). Queuing traffic for 10 km\0"
+    "(Q) shed load(s). Danger of queuing traffic\0"
+    "(Q) shed load(s). Slow traffic\0"
+    "(Q) shed load(s). Slow traffic for 1 km\0"
+    "(Q) shed load(s). Slow traffic for 2 km\0"
+    "(Q) shed load(s). Slow traffic for 4 km\0"
+    "(Q) shed load(s). Slow traffic for 6 km\0"
+    "(Q) shed load(s). Slow traffic for 10 km\0"
+    "(Q) shed load(s). Slow traffic expected\0"
+    "(Q) shed load(s). Heavy traffic\0"
+    "(Q) shed load(s). Heavy traffic expected\0"
+    "(Q) shed load(s). Traffic building up\0"
+    "blocked by (Q) shed load(s)\0"
+    "(Q) shed load(s). Right lane blocked\0"
+    "(Q) shed load(s). Centre lane blocked\0"
+    "(Q) shed load(s). Left lane blocked\0"
+    "(Q) shed load(s). Hard shoulder blocked\0"
+    "(Q) shed load(s). Two lanes blocked\0"
+    "(Q) shed load(s). Three lanes blocked\0"
+    "shed load. Delays (Q)\0"
+    "shed load. Delays (Q) expected\0"
+    "shed load. Long delays (Q)\0"
+    "(Q) broken down vehicle(s). Stationary traffic\0"
+    "(Q) broken down vehicle(s). Stationary traffic for 1 km\0"
+    "(Q) broken down vehicle(s). Stationary traffic for 2 km\0"
+    "(Q) broken down vehicle(s). Stationary traffic for 4 km\0"
+    "(Q) broken down vehicle(s). Stationary traffic for 6 km\0"
+    "(Q) broken down vehicle(s). Stationary traffic for 10 km\0"
+    "(Q) broken down vehicle(s). Danger of stationary traffic\0"
+    "(Q) broken down vehicle(s). Queuing traffic\0"
+    "(Q) broken down vehicle(s). Queuing traffic for 1 km\0"
+    "(Q) broken down vehicle(s). Queuing traffic for 2 km\0"
+    "(Q) broken down vehicle(s). Queuing traffic for 4 km\0"
+    "(Q) broken down vehicle(s). Queuing traffic for 6 km\0"
+    "(Q) broken down vehicle(s). Queuing traffic for 10 km\0"
+    "(Q) broken down vehicle(s). Danger of queuing traffic\0"
+    "(Q) broken down vehicle(s). Slow traffic\0"
+    "(Q) broken down vehicle(s). Slow traffic for 1 km\0"
+    "(Q) broken down vehicle(s). Slow traffic for 2 km\0"
+    "(Q) broken down vehicle(s). Slow traffic for 4 km\0"
+    "(Q) broken down vehicle(s). Slow traffic for 6 km\0"
+    "(Q) broken down vehicle(s). Slow traffic for 10 km\0"
+    "(Q) broken down vehicle(s). Slow traffic expected\0"
+    "(Q) broken down vehicle(s). Heavy traffic\0"
+    "(Q) broken down vehicle(s). Heavy traffic expected\0"
+    "(Q) broken down vehicle(s). Traffic building up\0"
+    "blocked by (Q) broken down vehicle(s)\0"
+    "(Q) broken down vehicle(s). Right lane blocked\0"
+    "(Q) broken down vehicle(s). Centre lane blocked\0"
+    "(Q) broken down vehicle(s). Left lane blocked\0"
+    "(Q) broken down vehicle(s). Hard shoulder blocked\0"
+    "(Q) broken down vehicle(s). Two lanes blocked\0"
+    "(Q) broken down vehicle(s). Three lanes blocked\0"
+    "broken down vehicle. Delays (Q)\0"
+    "broken down vehicle. Delays (Q) expected\0"
+    "broken down vehicle. Long delays (Q)\0"
+    "accident cleared\0"
+    "closed\0"
+    "blocked\0"
+    "closed for heavy vehicles over Q\0"
+    "no through traffic for heavy lorries over Q\0"
+    "no through traffic\0"
+    "(Q th) entry slip road closed\0"
+    "(Q th) exit slip road closed\0"
+    "slip roads closed\0"
+    "slip road restrictions\0"
+    "closed ahead. Stationary traffic\0"
+    "closed ahead. Stationary traffic for 1 km\0"
+    "closed ahead. Stationary traffic for 2 km\0"
+    "closed ahead. Stationary traffic for 4 km\0"
+    "closed ahead. Stationary traffic for 6 km\0"
+    "closed ahead. Stationary traffic for 10 km\0"
+    "closed ahead. Danger of stationary traffic\0"
+    "closed ahead. Queuing traffic\0"
+    "closed ahead. Queuing traffic for 1 km\0"
+    "closed ahead. Queuing traffic for 2 km\0"
+    "closed ahead. Queuing traffic for 4 km\0"
+    "closed ahead. Queuing traffic for 6 km\0"
+    "closed ahead. Queuing traffic for 10 km\0"
+    "closed ahead. Danger of queuing traffic\0"
+    "closed ahead. Slow traffic\0"
+    "closed ahead. Slow traffic for 1 km\0"
+    "closed ahead. Slow traffic for 2 km\0"
+    "closed ahead. Slow traffic for 4 km\0"
+    "closed ahead. Slow traffic for 6 km\0"
+    "closed ahead. Slow traffic for 10 km\0"
+    "closed ahead. Slow traffic expected\0"
+    "closed ahead. Heavy traffic\0"
+    "closed ahead. Heavy traffic expected\0"
+    "closed ahead. Traffic flowing freely\0"
+    "closed ahead. Traffic building up\0"
+    "closed ahead. Delays (Q)\0"
+    "closed ahead. Delays (Q) expected\0"
+    "closed ahead. Long delays (Q)\0"
+    "blocked ahead. Stationary traffic\0"
+    "blocked ahead. Stationary traffic for 1 km\0"
+    "blocked ahead. Stationary traffic for 2 km\0"
+    "blocked ahead. Stationary traffic for 4 km\0"
+    "blocked ahead. Stationary traffic for 6 km\0"
+    "blocked ahead. Stationary traffic for 10 km\0"
+    "blocked ahead. Danger of stationary traffic\0"
+    "blocked ahead. Queuing traffic\0"
+    "blocked ahead. Queuing traffic for 1 km\0"
+    "blocked ahead. Queuing traffic for 2 km\0"
+    "blocked ahead. Queuing traffic for 4 km\0"
+    "blocked ahead. Queuing traffic for 6 km\0"
+    "blocked ahead. Queuing traffic for 10 km\0"
+    "blocked ahead. Danger of queuing traffic\0"
+    "blocked ahead. Slow traffic\0"
+    "blocked ahead. Slow traffic for 1 km\0"
+    "blocked ahead. Slow traffic for 2 km\0"
+    "blocked ahead. Slow traffic for 4 km\0"
+    "blocked ahead. Slow traffic for 6 km\0"
+    "blocked ahead. Slow traffic for 10 km\0"
+    "blocked ahead. Slow traffic expected\0"
+    "blocked ahead. Heavy traffic\0"
+    "blocked ahead. Heavy traffic expected\0"
+    "blocked ahead. Traffic flowing freely\0"
+    "blocked ahead. Traffic building up\0"
+    "blocked ahead. Delays (Q)\0"
+    "blocked ahead. Delays (Q) expected\0"
+    "blocked ahead. Long delays (Q)\0"
+    "slip roads reopened\0"
+    "reopened\0"
+    "closed ahead\0"
+    "blocked ahead\0"
+    "(Q) lane(s) closed\0"
+    "(Q) right lane(s) closed\0"
+    "(Q) centre lane(s) closed\0"
+    "(Q) left lane(s) closed\0"
+    "hard shoulder closed\0"
+    "two lanes closed\0"
+    "three lanes closed\0"
+    "only one lane open\0"
+    "two lanes open\0"
+    "three lanes open\0"
+    "reduced from two to one lane\0"
+    "reduced from three to two lanes\0"
+    "reduced from three to one lane\0"
+    "contraflow\0"
+    "narrow lanes\0"
+    "contraflow with narrow lanes\0"
+    "single alternate line traffic\0"
+    "(Q sets of) roadworks\0"
+    "(Q sets of) major roadworks\0"
+    "(Q sets of) maintenance work\0"
+    "(Q sections of) resurfacing work\0"
+    "(Q sets of) central reservation work\0"
+    "(Q sets of) road marking work\0"
+    "bridge maintenance work (on Q bridges)\0"
+    "(Q sets of) temporary traffic lights\0"
+    "(Q sections of) blasting work\0"
+    "roadworks. Stationary traffic\0"
+    "roadworks. Stationary traffic for 1 km\0"
+    "roadworks. Stationary traffic for 2 km\0"
+    "roadworks. Stationary traffic for 4 km\0"
+    "roadworks. Stationary traffic for 6 km\0"
+    "roadworks. Stationary traffic for 10 km\0"
+    "roadworks. Danger of stationary traffic\0"
+    "roadworks. Queuing traffic\0"
+    "roadworks. Queuing traffic for 1 km\0"
+    "roadworks. Queuing traffic for 2 km\0"
+    "roadworks. Queuing traffic for 4 km\0"
+    "roadworks. Queuing traffic for 6 km\0"
+    "roadworks. Queuing traffic for 10 km\0"
+    "roadworks. Danger of queuing traffic\0"
+    "roadworks. Slow traffic\0"
+    "roadworks. Slow traffic for 1 km\0"
+    "roadworks. Slow traffic for 2 km\0"
+    "roadworks. Slow traffic for 4 km\0"
+    "roadworks. Slow traffic for 6 km\0"
+    "roadworks. Slow traffic for 10 km\0"
+    "roadworks. Slow traffic expected\0"
+    "roadworks. Heavy traffic\0"
+    "roadworks. Heavy traffic expected\0"
+    "roadworks. Traffic flowing freely\0"
+    "roadworks. Traffic building up\0"
+    "heavy snowfall (Q)\0"
+    "heavy snowfall (Q). Visibility reduced to <Q\0"
+    "heavy snowfall (Q). Visibility reduced to <30 m\0"
+    "snowfall (Q)\0"
+    "snowfall (Q). Visibility reduced to <Q\0"
+    "hail (visibility reduced to <Q)\0"
+    "sleet (visibility reduced to <Q)\0"
+    "thunderstorms (visibility reduced to <Q)\0"
+    "heavy rain (Q)\0"
+    "heavy rain (Q). Visibility reduced to <Q\0"
+    "rain (Q)\0"
+    "rain (Q). Visibility reduced to <Q\0"
+    "tornadoes\0"
+    "hurricane force winds (Q)\0"
+    "gales (Q)\0"
+    "storm force winds (Q)\0"
+    "strong winds (Q)\0"
+    "dense fog (visibility reduced to <Q)\0"
+    "dense fog. Visibility reduced to <30 m\0"
+    "dense fog. Visibility reduced to <50 m\0"
+    "fog (visibility reduced to <Q)\0"
+    "patchy fog (visibility reduced to <Q)\0"
+    "freezing fog (visibility reduced to <Q)\0"
+    "smoke hazard (visibility reduced to <Q)\0"
+    "blowing dust (visibility reduced to <Q)\0"
+    "major event\0"
+    "sports meeting\0"
+    "fair\0"
+    ;
+
+/** The offset in kTMCEventTextData of each text index. */
+static const uint16_t kTMCEventTextOffset[339] = {
+    0,
+    1,
+    17,
+    87,
+    106,
+    134,
+    162,
+    190,
+    218,
+    247,
+    275,
+    315,
+    364,
+    413,
+    462,
+    511,
+    561,
+    586,
+    623,
+    669,
+    715,
+    761,
+    807,
+    854,
+    876,
+    914,
+    937,
+    984,
+    1028,
+    1050,
+    1077,
+    1095,
+    1123,
+    1152,
+    1201,
+    1251,
+    1287,
+    1333,
+    1348,
+    1391,
+    1443,
+    1503,
+    1545,
+    1586,
+    1631,
+    1683,
+    1745,
+    1757,
+    1777,
+    1823,
+    1866,
+    1912,
+    1942,
+    1976,
+    2020,
+    2058,
+    2075,
+    2102,
+    2136,
+    2156,
+    2172,
+    2208,
+    2253,
+    2298,
+    2343,
+    2388,
+    2434,
+    2480,
+    2513,
+    2555,
+    2597,
+    2639,
+    2681,
+    2724,
+    2767,
+    2797,
+    2836,
+    2875,
+    2914,
+    2953,
+    2993,
+    3032,
+    3063,
+    3103,
+    3143,
+    3180,
+    3215,
+    3251,
+    3288,
+    3323,
+    3362,
+    3397,
+    3434,
+    3455,
+    3485,
+    3511,
+    3575,
+    3648,
+    3721,
+    3794,
+    3867,
+    3941,
+    4015,
+    4076,
+    4146,
+    4216,
+    4286,
+    4356,
+    4427,
+    4498,
+    4556,
+    4623,
+    4690,
+    4757,
+    4824,
+    4892,
+    4959,
+    5018,
+    5086,
+    5151,
+    5200,
+    5258,
+    5312,
+    5349,
+    5395,
+    5441,
+    5487,
+    5533,
+    5580,
+    5627,
+    5661,
+    5704,
+    5747,
+    5790,
+    5833,
+    5877,
+    5921,
+    5952,
+    5992,
+    6032,
+    6072,
+    6112,
+    6153,
+    6193,
+    6225,
+    6266,
+    6304,
+    6332,
+    6369,
+    6407,
+    6443,
+    6483,
+    6519,
+    6557,
+    6579,
+    6610,
+    6637,
+    6684,
+    6740,
+    6796,
+    6852,
+    6908,
+    6965,
+    7022,
+    7066,
+    7119,
+    7172,
+    7225,
+    7278,
+    7332,
+    7386,
+    7427,
+    7477,
+    7527,
+    7577,
+    7627,
+    7678,
+    7728,
+    7770,
+    7821,
+    7869,
+    7907,
+    7954,
+    8002,
+    8048,
+    8098,
+    8144,
+    8192,
+    8224,
+    8265,
+    8302,
+    8319,
+    8326,
+    8334,
+    8367,
+    8411,
+    8430,
+    8460,
+    8489,
+    8507,
+    8530,
+    8563,
+    8605,
+    8647,
+    8689,
+    8731,
+    8774,
+    8817,
+    8847,
+    8886,
+    8925,
+    8964,
+    9003,
+    9043,
+    9083,
+    9110,
+    9146,
+    9182,
+    9218,
+    9254,
+    9291,
+    9327,
+    9355,
+    9392,
+    9429,
+    9463,
+    9488,
+    9522,
+    9552,
+    9586,
+    9629,
+    9672,
+    9715,
+    9758,
+    9802,
+    9846,
+    9877,
+    9917,
+    9957,
+    9997,
+    10037,
+    10078,
+    10119,
+    10147,
+    10184,
+    10221,
+    10258,
+    10295,
+    10333,
+    10370,
+    10399,
+    10437,
+    10475,
+    10510,
+    10536,
+    10571,
+    10602,
+    10622,
+    10631,
+    10644,
+    10658,
+    10677,
+    10702,
+    10728,
+    10752,
+    10773,
+    10790,
+    10809,
+    10828,
+    10843,
+    10860,
+    10889,
+    10921,
+    10952,
+    10963,
+    10976,
+    11005,
+    11035,
+    11057,
+    11085,
+    11114,
+    11147,
+    11184,
+    11214,
+    11253,
+    11290,
+    11320,
+    11350,
+    11389,
+    11428,
+    11467,
+    11506,
+    11546,
+    11586,
+    11613,
+    11649,
+    11685,
+    11721,
+    11757,
+    11794,
+    11831,
+    11855,
+    11888,
+    11921,
+    11954,
+    11987,
+    12021,
+    12054,
+    12079,
+    12113,
+    12147,
+    12178,
+    12197,
+    12242,
+    12290,
+    12303,
+    12342,
+    12374,
+    12407,
+    12448,
+    12463,
+    12504,
+    12513,
+    12548,
+    12558,
+    12584,
+    12594,
+    12616,
+    12633,
+    12670,
+    12709,
+    12748,
+    12779,
+    12817,
+    12857,
+    12897,
+    12937,
+    12949,
+    12964,
+};
+
+/** The event list, indexed by event code. Unlisted events are zero. */
+static const uint32_t kTMCEvents[TMC_NUM_EVENTS] = {
+    [1] = EVENT(1, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 1, 0),
+    [2] = EVENT(2, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [101] = EVENT(3, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 1, 0),
+    [102] = EVENT(4, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 1, 0),
+    [103] = EVENT(5, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 1, 0),
+    [104] = EVENT(6, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 1, 0),
+    [105] = EVENT(7, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 1, 0),
+    [106] = EVENT(8, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 1, 0),
+    [107] = EVENT(9, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 2, 0),
+    [108] = EVENT(10, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [109] = EVENT(11, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [110] = EVENT(12, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [111] = EVENT(13, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [112] = EVENT(14, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [113] = EVENT(15, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [114] = EVENT(16, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 2, 0),
+    [115] = EVENT(17, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [116] = EVENT(18, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [117] = EVENT(19, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [118] = EVENT(20, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [119] = EVENT(21, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [120] = EVENT(22, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [121] = EVENT(23, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 2, 0),
+    [122] = EVENT(24, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [123] = EVENT(25, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 2, 0),
+    [124] = EVENT(26, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [125] = EVENT(27, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [126] = EVENT(28, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 1, 0),
+    [127] = EVENT(29, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 1, 0),
+    [128] = EVENT(30, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 1, 0),
+    [129] = EVENT(31, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 1, 0),
+    [130] = EVENT(32, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 1, 0),
+    [131] = EVENT(33, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [132] = EVENT(34, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [133] = EVENT(35, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [134] = EVENT(36, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [135] = EVENT(37, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 1, 0),
+    [136] = EVENT(38, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [137] = EVENT(39, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [138] = EVENT(40, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [139] = EVENT(41, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 1, 0),
+    [140] = EVENT(42, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 1, 0),
+    [141] = EVENT(43, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 1, 0),
+    [142] = EVENT(44, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [143] = EVENT(45, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 0, 1, 0),
+    [201] = EVENT(46, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_NONE, 0, 0, 3, 0),
+    [202] = EVENT(47, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_NONE, 0, 0, 3, 0),
+    [203] = EVENT(48, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [204] = EVENT(49, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [205] = EVENT(50, TMC_NATURE_INFO, TMC_URGENCY_EXTREMELY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [206] = EVENT(51, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [207] = EVENT(52, TMC_NATURE_INFO, TMC_URGENCY_EXTREMELY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [208] = EVENT(53, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [209] = EVENT(54, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [210] = EVENT(55, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [211] = EVENT(56, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [212] = EVENT(57, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [213] = EVENT(58, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [214] = EVENT(59, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [215] = EVENT(60, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [216] = EVENT(61, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [217] = EVENT(62, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [218] = EVENT(63, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [219] = EVENT(64, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [220] = EVENT(65, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [221] = EVENT(66, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [222] = EVENT(67, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [223] = EVENT(68, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [224] = EVENT(69, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [225] = EVENT(70, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [226] = EVENT(71, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [227] = EVENT(72, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [228] = EVENT(73, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [229] = EVENT(74, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [230] = EVENT(75, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [231] = EVENT(76, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [232] = EVENT(77, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [233] = EVENT(78, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [234] = EVENT(79, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [235] = EVENT(80, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [236] = EVENT(81, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [237] = EVENT(82, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [238] = EVENT(83, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [239] = EVENT(84, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [240] = EVENT(85, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [241] = EVENT(86, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [242] = EVENT(87, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [243] = EVENT(88, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [244] = EVENT(89, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [245] = EVENT(90, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [246] = EVENT(91, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [247] = EVENT(92, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_DURATION, 0, 0, 3, 0),
+    [248] = EVENT(93, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_DURATION, 0, 0, 3, 0),
+    [249] = EVENT(94, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_DURATION, 0, 0, 3, 0),
+    [250] = EVENT(95, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [251] = EVENT(96, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [252] = EVENT(97, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [253] = EVENT(98, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [254] = EVENT(99, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [255] = EVENT(100, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [256] = EVENT(101, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [257] = EVENT(102, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [258] = EVENT(103, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [259] = EVENT(104, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [260] = EVENT(105, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [261] = EVENT(106, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [262] = EVENT(107, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [263] = EVENT(108, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [264] = EVENT(109, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [265] = EVENT(110, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [266] = EVENT(111, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [267] = EVENT(112, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [268] = EVENT(113, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [269] = EVENT(114, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [270] = EVENT(115, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [271] = EVENT(116, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [272] = EVENT(117, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [273] = EVENT(118, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [274] = EVENT(119, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_DURATION, 0, 0, 3, 0),
+    [275] = EVENT(120, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_DURATION, 0, 0, 3, 0),
+    [276] = EVENT(121, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_DURATION, 0, 0, 3, 0),
+    [277] = EVENT(122, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [278] = EVENT(123, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [279] = EVENT(124, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [280] = EVENT(125, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [281] = EVENT(126, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [282] = EVENT(127, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [283] = EVENT(128, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [284] = EVENT(129, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [285] = EVENT(130, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [286] = EVENT(131, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [287] = EVENT(132, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [288] = EVENT(133, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [289] = EVENT(134, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [290] = EVENT(135, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [291] = EVENT(136, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [292] = EVENT(137, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [293] = EVENT(138, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [294] = EVENT(139, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [295] = EVENT(140, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [296] = EVENT(141, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [297] = EVENT(142, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [298] = EVENT(143, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [299] = EVENT(144, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [300] = EVENT(145, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [301] = EVENT(146, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [302] = EVENT(147, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [303] = EVENT(148, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [304] = EVENT(149, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [305] = EVENT(150, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [306] = EVENT(151, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [307] = EVENT(152, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [308] = EVENT(153, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_DURATION, 0, 0, 3, 0),
+    [309] = EVENT(154, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_DURATION, 0, 0, 3, 0),
+    [310] = EVENT(155, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_DURATION, 0, 0, 3, 0),
+    [311] = EVENT(156, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [312] = EVENT(157, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [313] = EVENT(158, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [314] = EVENT(159, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [315] = EVENT(160, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [316] = EVENT(161, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [317] = EVENT(162, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [318] = EVENT(163, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [319] = EVENT(164, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [320] = EVENT(165, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [321] = EVENT(166, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [322] = EVENT(167, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [323] = EVENT(168, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [324] = EVENT(169, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [325] = EVENT(170, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [326] = EVENT(171, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [327] = EVENT(172, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [328] = EVENT(173, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [329] = EVENT(174, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [330] = EVENT(175, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [331] = EVENT(176, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [332] = EVENT(177, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [333] = EVENT(178, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [334] = EVENT(179, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [335] = EVENT(180, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [336] = EVENT(181, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [337] = EVENT(182, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [338] = EVENT(183, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [339] = EVENT(184, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [340] = EVENT(185, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [341] = EVENT(186, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 0, 0, 3, 0),
+    [342] = EVENT(187, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_DURATION, 0, 0, 3, 0),
+    [343] = EVENT(188, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_DURATION, 0, 0, 3, 0),
+    [344] = EVENT(189, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_DURATION, 0, 0, 3, 0),
+    [345] = EVENT(190, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 3, 0),
+    [401] = EVENT(191, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 1, 0, 5, 3),
+    [402] = EVENT(192, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [403] = EVENT(193, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_WEIGHT, 1, 0, 9, 3),
+    [404] = EVENT(194, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_WEIGHT, 1, 0, 9, 3),
+    [405] = EVENT(195, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 1, 0, 9, 3),
+    [406] = EVENT(196, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 1, 0, 8, 3),
+    [407] = EVENT(197, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 1, 0, 7, 3),
+    [408] = EVENT(198, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 1, 0, 7, 3),
+    [409] = EVENT(199, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 1, 0, 7, 3),
+    [410] = EVENT(200, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [411] = EVENT(201, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [412] = EVENT(202, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [413] = EVENT(203, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [414] = EVENT(204, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [415] = EVENT(205, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [416] = EVENT(206, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [417] = EVENT(207, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [418] = EVENT(208, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [419] = EVENT(209, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [420] = EVENT(210, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [421] = EVENT(211, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [422] = EVENT(212, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [423] = EVENT(213, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [424] = EVENT(214, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [425] = EVENT(215, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [426] = EVENT(216, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [427] = EVENT(217, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [428] = EVENT(218, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [429] = EVENT(219, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [430] = EVENT(220, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [431] = EVENT(221, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [432] = EVENT(222, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [433] = EVENT(223, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [434] = EVENT(224, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [435] = EVENT(225, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_DURATION, 0, 0, 5, 0),
+    [436] = EVENT(226, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_DURATION, 0, 0, 5, 0),
+    [437] = EVENT(227, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_DURATION, 0, 0, 5, 0),
+    [438] = EVENT(228, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [439] = EVENT(229, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [440] = EVENT(230, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [441] = EVENT(231, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [442] = EVENT(232, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [443] = EVENT(233, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [444] = EVENT(234, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [445] = EVENT(235, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [446] = EVENT(236, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [447] = EVENT(237, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [448] = EVENT(238, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [449] = EVENT(239, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [450] = EVENT(240, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [451] = EVENT(241, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [452] = EVENT(242, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [453] = EVENT(243, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [454] = EVENT(244, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [455] = EVENT(245, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [456] = EVENT(246, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [457] = EVENT(247, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [458] = EVENT(248, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [459] = EVENT(249, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [460] = EVENT(250, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [461] = EVENT(251, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [462] = EVENT(252, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [463] = EVENT(253, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_DURATION, 0, 0, 5, 0),
+    [464] = EVENT(254, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_DURATION, 0, 0, 5, 0),
+    [465] = EVENT(255, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_DURATION, 0, 0, 5, 0),
+    [466] = EVENT(256, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 7, 0),
+    [467] = EVENT(257, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [468] = EVENT(30, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [469] = EVENT(258, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [470] = EVENT(259, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 5, 0),
+    [500] = EVENT(260, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 1, 0, 5, 3),
+    [501] = EVENT(261, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 1, 0, 5, 3),
+    [502] = EVENT(262, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 1, 0, 5, 3),
+    [503] = EVENT(263, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 1, 0, 5, 3),
+    [504] = EVENT(264, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 1, 0, 5, 3),
+    [505] = EVENT(265, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 1, 0, 5, 3),
+    [506] = EVENT(266, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 1, 0, 5, 3),
+    [507] = EVENT(267, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 1, 0, 5, 3),
+    [508] = EVENT(268, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 1, 0, 5, 3),
+    [509] = EVENT(269, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 1, 0, 5, 3),
+    [510] = EVENT(270, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 1, 0, 5, 3),
+    [511] = EVENT(271, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 1, 0, 5, 3),
+    [512] = EVENT(272, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 1, 0, 5, 3),
+    [513] = EVENT(273, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 1, 0, 5, 3),
+    [514] = EVENT(274, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 1, 0, 5, 3),
+    [515] = EVENT(275, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 1, 0, 5, 3),
+    [516] = EVENT(276, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 1, 0, 5, 3),
+    [701] = EVENT(277, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 1, 0, 11, 3),
+    [702] = EVENT(278, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 1, 0, 11, 3),
+    [703] = EVENT(279, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 1, 0, 11, 3),
+    [704] = EVENT(280, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 1, 0, 11, 3),
+    [705] = EVENT(281, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 1, 0, 11, 3),
+    [706] = EVENT(282, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 1, 0, 11, 3),
+    [707] = EVENT(283, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 1, 0, 11, 3),
+    [708] = EVENT(284, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 1, 0, 11, 3),
+    [709] = EVENT(285, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SMALL_NUMBER, 1, 0, 11, 3),
+    [710] = EVENT(286, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [711] = EVENT(287, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [712] = EVENT(288, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [713] = EVENT(289, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [714] = EVENT(290, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [715] = EVENT(291, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [716] = EVENT(292, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [717] = EVENT(293, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [718] = EVENT(294, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [719] = EVENT(295, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [720] = EVENT(296, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [721] = EVENT(297, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [722] = EVENT(298, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [723] = EVENT(299, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [724] = EVENT(300, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [725] = EVENT(301, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [726] = EVENT(302, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [727] = EVENT(303, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [728] = EVENT(304, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [729] = EVENT(305, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [730] = EVENT(306, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [731] = EVENT(307, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [732] = EVENT(308, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [733] = EVENT(309, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [734] = EVENT(310, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 0, 11, 0),
+    [1101] = EVENT(311, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_PRECIPITATION, 0, 1, 16, 0),
+    [1102] = EVENT(312, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_LESS_THAN_METRES, 0, 1, 16, 0),
+    [1103] = EVENT(313, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_PRECIPITATION, 0, 1, 16, 0),
+    [1104] = EVENT(314, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_PRECIPITATION, 0, 1, 16, 0),
+    [1105] = EVENT(315, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_LESS_THAN_METRES, 0, 1, 16, 0),
+    [1106] = EVENT(316, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_LESS_THAN_METRES, 0, 1, 16, 0),
+    [1107] = EVENT(317, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_LESS_THAN_METRES, 0, 1, 16, 0),
+    [1108] = EVENT(318, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_LESS_THAN_METRES, 0, 1, 16, 0),
+    [1109] = EVENT(319, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_PRECIPITATION, 0, 1, 16, 0),
+    [1110] = EVENT(320, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_LESS_THAN_METRES, 0, 1, 16, 0),
+    [1111] = EVENT(321, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_PRECIPITATION, 0, 1, 16, 0),
+    [1112] = EVENT(322, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_LESS_THAN_METRES, 0, 1, 16, 0),
+    [1201] = EVENT(323, TMC_NATURE_INFO, TMC_URGENCY_EXTREMELY_URGENT, TMC_Q_NONE, 0, 1, 17, 0),
+    [1202] = EVENT(324, TMC_NATURE_INFO, TMC_URGENCY_EXTREMELY_URGENT, TMC_Q_SPEED, 0, 1, 17, 0),
+    [1203] = EVENT(325, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SPEED, 0, 1, 17, 0),
+    [1204] = EVENT(326, TMC_NATURE_INFO, TMC_URGENCY_URGENT, TMC_Q_SPEED, 0, 1, 17, 0),
+    [1205] = EVENT(327, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_SPEED, 0, 1, 17, 0),
+    [1301] = EVENT(328, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_LESS_THAN_METRES, 0, 1, 16, 0),
+    [1302] = EVENT(329, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 1, 16, 0),
+    [1303] = EVENT(330, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 0, 1, 16, 0),
+    [1304] = EVENT(331, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_LESS_THAN_METRES, 0, 1, 16, 0),
+    [1305] = EVENT(332, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_LESS_THAN_METRES, 0, 1, 16, 0),
+    [1306] = EVENT(333, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_LESS_THAN_METRES, 0, 1, 16, 0),
+    [1307] = EVENT(334, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_LESS_THAN_METRES, 0, 1, 16, 0),
+    [1308] = EVENT(335, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_LESS_THAN_METRES, 0, 1, 16, 0),
+    [1501] = EVENT(336, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 1, 1, 18, 3),
+    [1502] = EVENT(337, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 1, 1, 18, 3),
+    [1503] = EVENT(338, TMC_NATURE_INFO, TMC_URGENCY_NORMAL, TMC_Q_NONE, 1, 1, 18, 3),
+};
+
+// clang-format on
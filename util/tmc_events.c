@@ -0,0 +1,142 @@
+/**
+ * @file
+ *
+ * @author Chris Mumford
+ *
+ * @license
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "tmc_events.h"
+
+#include <stdio.h>
+
+// clang-format off
+
+// Each catalogue entry is packed into 32 bits:
+#define EVT_TEXT_BITS   0x000007FF  // Index into kTMCEventTextOffset.
+#define EVT_NATURE      0x00001800
+#define EVT_URGENCY     0x00006000
+#define EVT_QUANTIFIER  0x00078000
+#define EVT_LONGER      0x00080000  // Longer lasting (else dynamic).
+#define EVT_BIDIR       0x00100000  // Bidirectional.
+#define EVT_CLASS       0x07E00000  // Update class.
+#define EVT_DURATION    0x38000000  // Default duration.
+
+// clang-format on
+
+#define EVENT(TEXT, NATURE, URGENCY, QUANTIFIER, LONGER, BIDIR, CLASS,        \
+              DURATION)                                                      \
+  ((uint32_t)(TEXT) | (uint32_t)(NATURE) << 11 | (uint32_t)(URGENCY) << 13 | \
+   (uint32_t)(QUANTIFIER) << 15 | (uint32_t)(LONGER) << 19 |                 \
+   (uint32_t)(BIDIR) << 20 | (uint32_t)(CLASS) << 21 |                       \
+   (uint32_t)(DURATION) << 27)
+
+// The ISO 14819-2 event list (kTMCEvents) and its text, generated from
+// tmc_event_list.csv by tmc_event_compiler.
+#include "tmc_event_table.h"
+
+bool get_tmc_event_info(uint16_t event, struct tmc_event_info* info) {
+  const uint32_t entry = event < TMC_NUM_EVENTS ? kTMCEvents[event] : 0;
+  const uint16_t text = entry & EVT_TEXT_BITS;
+  info->text = text ? kTMCEventTextData + kTMCEventTextOffset[text] : NULL;
+  info->nature = (enum tmc_event_nature)((entry & EVT_NATURE) >> 11);
+  info->urgency = (enum tmc_urgency)((entry & EVT_URGENCY) >> 13);
+  info->quantifier =
+      entry ? (enum tmc_quantifier_type)((entry & EVT_QUANTIFIER) >> 15)
+            : TMC_Q_NONE;
+  info->longer_lasting = entry & EVT_LONGER;
+  info->bidirectional = entry & EVT_BIDIR;
+  info->update_class = (entry & EVT_CLASS) >> 21;
+  info->default_duration = (entry & EVT_DURATION) >> 27;
+  return text != 0;
+}
+
+const char* get_tmc_event_text(uint16_t event) {
+  const uint16_t text =
+      event < TMC_NUM_EVENTS ? kTMCEvents[event] & EVT_TEXT_BITS : 0;
+  return text ? kTMCEventTextData + kTMCEventTextOffset[text] : NULL;
+}
+
+bool format_tmc_quantifier(char* buffer,
+                           size_t buffer_len,
+                           enum tmc_quantifier_type type,
+                           uint8_t value) {
+  if (type <= TMC_Q_DURATION && value > 31)
+    return false;
+  // The 5 bit quantifiers use zero for the largest value.
+  const unsigned q = (type <= TMC_Q_DURATION && value == 0) ? 32 : value;
+  unsigned v;
+  switch (type) {
+    case TMC_Q_SMALL_NUMBER:
+      v = q <= 28 ? q : 28 + (q - 28) * 2;
+      snprintf(buffer, buffer_len, "%u", v);
+      return true;
+    case TMC_Q_NUMBER:
+      if (q <= 4)
+        v = q;
+      else if (q <= 14)
+        v = (q - 4) * 10;
+      else
+        v = 100 + (q - 14) * 50;
+      snprintf(buffer, buffer_len, "%u", v);
+      return true;
+    case TMC_Q_LESS_THAN_METRES:
+      snprintf(buffer, buffer_len, "less than %u m", q * 10);
+      return true;
+    case TMC_Q_PERCENT:
+      snprintf(buffer, buffer_len, "%u %%", (q - 1) * 5);
+      return true;
+    case TMC_Q_SPEED:
+      snprintf(buffer, buffer_len, "%u km/h", q * 5);
+      return true;
+    case TMC_Q_DURATION:
+      if (q <= 10)
+        snprintf(buffer, buffer_len, "%u minutes", q * 5);
+      else if (q <= 22)
+        snprintf(buffer, buffer_len, "%u hours", q - 10);
+      else
+        snprintf(buffer, buffer_len, "%u hours", (q - 20) * 6);
+      return true;
+    case TMC_Q_TEMPERATURE:
+      snprintf(buffer, buffer_len, "%d C", (int)q - 51);
+      return true;
+    case TMC_Q_TIME:
+      if (q == 0 || q > 144)
+        return false;
+      snprintf(buffer, buffer_len, "%02u:%02u", (q - 1) / 6, (q - 1) % 6 * 10);
+      return true;
+    case TMC_Q_WEIGHT:
+    case TMC_Q_LENGTH:
+      // 0.1 units up to 10, then 0.5 units.
+      v = q <= 100 ? q : 100 + (q - 100) * 5;
+      snprintf(buffer, buffer_len, "%u.%u %s", v / 10, v % 10,
+               type == TMC_Q_WEIGHT ? "t" : "m");
+      return true;
+    case TMC_Q_PRECIPITATION:
+      snprintf(buffer, buffer_len, "%u mm", q);
+      return true;
+    case TMC_Q_FM_FREQUENCY:
+      if (q == 0 || q > 204)
+        return false;
+      v = 875 + q;
+      snprintf(buffer, buffer_len, "%u.%u MHz", v / 10, v % 10);
+      return true;
+    case TMC_Q_AM_FREQUENCY:
+      if (q == 0)
+        return false;
+      // LF (153-279 kHz) then MF (531-1602 kHz) in 9 kHz steps.
+      v = q <= 15 ? 144 + q * 9 : 531 + (q - 16) * 9;
+      snprintf(buffer, buffer_len, "%u kHz", v);
+      return true;
+    case TMC_Q_NONE:
+      break;
+  }
+  return false;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file
+ *
+ * @author Chris Mumford
+ *
+ * @license
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/** The number of TMC event codes (11 bits). */
+#define TMC_NUM_EVENTS 2048
+
+/** The nature of an event (ISO 14819-2 section 5.3). */
+enum tmc_event_nature {
+  TMC_NATURE_INFO,      ///< Information (the default).
+  TMC_NATURE_FORECAST,  ///< Forecast.
+  TMC_NATURE_SILENT,    ///< Silent.
+};
+
+/** The urgency of an event (ISO 14819-2 section 5.4). */
+enum tmc_urgency {
+  TMC_URGENCY_NORMAL,
+  TMC_URGENCY_URGENT,
+  TMC_URGENCY_EXTREMELY_URGENT,
+};
+
+/** How a quantifier value is to be interpreted (ISO 14819-2 section 5.5). */
+enum tmc_quantifier_type {
+  TMC_Q_SMALL_NUMBER = 0,  ///< 5 bit quantifiers (label 4).
+  TMC_Q_NUMBER = 1,
+  TMC_Q_LESS_THAN_METRES = 2,
+  TMC_Q_PERCENT = 3,
+  TMC_Q_SPEED = 4,
+  TMC_Q_DURATION = 5,
+  TMC_Q_TEMPERATURE = 6,  ///< 8 bit quantifiers (label 5).
+  TMC_Q_TIME = 7,
+  TMC_Q_WEIGHT = 8,
+  TMC_Q_LENGTH = 9,
+  TMC_Q_PRECIPITATION = 10,
+  TMC_Q_FM_FREQUENCY = 11,
+  TMC_Q_AM_FREQUENCY = 12,
+  TMC_Q_NONE = 15,  ///< The event takes no quantifier.
+};
+
+struct tmc_event_info {
+  const char* text;  ///< English text, or NULL if the event is unknown.
+  enum tmc_event_nature nature;
+  enum tmc_urgency urgency;
+  enum tmc_quantifier_type quantifier;
+  bool longer_lasting;   ///< Duration type: true=longer lasting, else dynamic.
+  bool bidirectional;    ///< The event affects both directions.
+  uint8_t update_class;  ///< Update class (1..39), or 0 if unknown.
+  uint8_t default_duration;  ///< Duration (DP) when a message gives none.
+};
+
+/**
+ * Get the catalogue entry for |event|. Returns false (and a NULL text) if
+ * the event is not in the catalogue.
+ */
+bool get_tmc_event_info(uint16_t event, struct tmc_event_info* info);
+
+/**
+ * Get the English text for |event|, or NULL if it is not in the catalogue.
+ */
+const char* get_tmc_event_text(uint16_t event);
+
+/**
+ * Write the value of quantifier |value| of type |type| to |buffer| (with
+ * units, e.g. "30 km/h"). Returns false if |type| has no quantifier or the
+ * value is reserved.
+ */
+bool format_tmc_quantifier(char* buffer,
+                           size_t buffer_len,
+                           enum tmc_quantifier_type type,
+                           uint8_t value);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
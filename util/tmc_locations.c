@@ -0,0 +1,151 @@
+/**
+ * @file
+ *
+ * @author Chris Mumford
+ *
+ * @license
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "tmc_locations.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct tmc_location_index {
+  const uint8_t* base;  ///< The mapped file.
+  size_t size;          ///< The size of the mapping.
+  const char* strings;
+  uint32_t strings_size;
+  const struct tmc_index_table* tables[TMC_NUM_LTN];  ///< Indexed by LTN.
+};
+
+static bool in_file(size_t file_size, uint32_t offset, size_t len) {
+  return offset <= file_size && len <= file_size - offset;
+}
+
+/**
+ * Check the header and the table directory. Only the directory is read, so
+ * this does not depend on the size of the tables.
+ */
+static bool load_tables(struct tmc_location_index* index) {
+  if (index->size < sizeof(struct tmc_index_header))
+    return false;
+  const struct tmc_index_header* header =
+      (const struct tmc_index_header*)index->base;
+  if (header->magic != TMC_INDEX_MAGIC ||
+      header->version != TMC_INDEX_VERSION ||
+      header->file_size != index->size ||
+      !in_file(index->size, header->strings_offset, header->strings_size) ||
+      header->strings_size == 0 ||
+      !in_file(index->size, sizeof(*header),
+               header->num_tables * sizeof(struct tmc_index_table))) {
+    return false;
+  }
+  index->strings = (const char*)index->base + header->strings_offset;
+  index->strings_size = header->strings_size;
+  if (index->strings[index->strings_size - 1] != '\0')
+    return false;
+
+  const struct tmc_index_table* tables =
+      (const struct tmc_index_table*)(header + 1);
+  for (uint16_t i = 0; i < header->num_tables; i++) {
+    const struct tmc_index_table* table = &tables[i];
+    if (table->ltn >= TMC_NUM_LTN || table->min_lcd > table->max_lcd ||
+        table->slots_offset % sizeof(uint32_t) ||
+        table->records_offset % sizeof(uint32_t) ||
+        !in_file(index->size, table->slots_offset,
+                 (table->max_lcd - table->min_lcd + 1u) * sizeof(uint32_t)) ||
+        !in_file(index->size, table->records_offset,
+                 table->num_records * sizeof(struct tmc_index_record))) {
+      return false;
+    }
+    index->tables[table->ltn] = table;
+  }
+  return true;
+}
+
+struct tmc_location_index* open_tmc_location_index(const char* fname) {
+  const int fd = open(fname, O_RDONLY);
+  if (fd == -1)
+    return NULL;
+  struct stat sb;
+  if (fstat(fd, &sb) == -1 || sb.st_size <= 0) {
+    close(fd);
+    return NULL;
+  }
+  void* base = mmap(NULL, sb.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED)
+    return NULL;
+
+  struct tmc_location_index* index = (struct tmc_location_index*)calloc(
+      1, sizeof(struct tmc_location_index));
+  if (!index) {
+    munmap(base, sb.st_size);
+    return NULL;
+  }
+  index->base = (const uint8_t*)base;
+  index->size = sb.st_size;
+  if (!load_tables(index)) {
+    close_tmc_location_index(index);
+    return NULL;
+  }
+  return index;
+}
+
+void close_tmc_location_index(struct tmc_location_index* index) {
+  if (!index)
+    return;
+  munmap((void*)index->base, index->size);
+  free(index);
+}
+
+static const char* get_string(const struct tmc_location_index* index,
+                              uint32_t offset) {
+  return offset < index->strings_size ? index->strings + offset
+                                      : index->strings;
+}
+
+bool get_tmc_location(const struct tmc_location_index* index,
+                      uint8_t ltn,
+                      uint16_t lcd,
+                      struct tmc_location* location) {
+  if (!index || ltn >= TMC_NUM_LTN)
+    return false;
+  const struct tmc_index_table* table = index->tables[ltn];
+  if (!table || lcd < table->min_lcd || lcd > table->max_lcd)
+    return false;
+  const uint32_t* slots = (const uint32_t*)(index->base + table->slots_offset);
+  const uint32_t slot = slots[lcd - table->min_lcd];
+  if (!slot || slot > table->num_records)
+    return false;
+  const struct tmc_index_record* rec =
+      (const struct tmc_index_record*)(index->base + table->records_offset) +
+      (slot - 1);
+
+  location->lcd = rec->lcd;
+  location->loc_class = rec->loc_class;
+  location->type = rec->type;
+  location->subtype = rec->subtype;
+  location->area_ref = rec->area_ref;
+  location->linear_ref = rec->linear_ref;
+  location->neg_offset = rec->neg_offset;
+  location->pos_offset = rec->pos_offset;
+  location->road_number = get_string(index, rec->road_number);
+  location->road_name = get_string(index, rec->road_name);
+  location->first_name = get_string(index, rec->first_name);
+  location->second_name = get_string(index, rec->second_name);
+  return true;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file
+ *
+ * @author Chris Mumford
+ *
+ * @license
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * The TMC location table index file format.
+ *
+ * An index holds one or more ISO 14819-3 location tables, each identified by
+ * its Location Table Number (LTN), and is built by tmc_location_compiler.
+ * The file is used in place (memory mapped), so every structure is naturally
+ * aligned and stored in the byte order of the host that built it. A file of
+ * the wrong byte order fails the magic check.
+ *
+ *   struct tmc_index_header
+ *   struct tmc_index_table[num_tables]
+ *   per table: uint32_t slots[max_lcd - min_lcd + 1]  (record # + 1, 0=none)
+ *   per table: struct tmc_index_record[num_records]
+ *   strings:   NUL terminated names. Offset 0 is the empty string.
+ */
+#define TMC_INDEX_MAGIC 0x4C434D54  // "TMCL"
+#define TMC_INDEX_VERSION 1
+
+/** The number of possible Location Table Numbers (6 bits). */
+#define TMC_NUM_LTN 64
+
+struct tmc_index_header {
+  uint32_t magic;           ///< TMC_INDEX_MAGIC.
+  uint16_t version;         ///< TMC_INDEX_VERSION.
+  uint16_t num_tables;      ///< # of struct tmc_index_table following.
+  uint32_t file_size;       ///< Total size of the file.
+  uint32_t strings_offset;  ///< File offset of the string data.
+  uint32_t strings_size;    ///< Size of the string data.
+  uint32_t reserved;
+};
+
+struct tmc_index_table {
+  uint8_t ltn;              ///< Location Table Number.
+  uint8_t reserved;
+  uint16_t min_lcd;         ///< Smallest location code in the table.
+  uint16_t max_lcd;         ///< Largest location code in the table.
+  uint16_t reserved2;
+  uint32_t slots_offset;    ///< File offset of the slot array.
+  uint32_t records_offset;  ///< File offset of the records.
+  uint32_t num_records;     ///< # of records.
+};
+
+struct tmc_index_record {
+  uint16_t lcd;          ///< Location code.
+  char loc_class;        ///< 'A'rea, 'L'inear, or 'P'oint.
+  uint8_t type;          ///< Type code (the 1 in "P1.3").
+  uint8_t subtype;       ///< Subtype code (the 3 in "P1.3").
+  uint8_t reserved;
+  uint16_t area_ref;     ///< Location code of the enclosing area, or 0.
+  uint16_t linear_ref;   ///< Location code of the enclosing road, or 0.
+  uint16_t neg_offset;   ///< Neighbour in the negative direction, or 0.
+  uint16_t pos_offset;   ///< Neighbour in the positive direction, or 0.
+  uint16_t reserved2;
+  uint32_t road_number;  ///< String offsets.
+  uint32_t road_name;
+  uint32_t first_name;
+  uint32_t second_name;
+};
+
+/**
+ * A decoded TMC location. The strings point into the mapped index and are
+ * valid until close_tmc_location_index(). Missing strings are empty.
+ */
+struct tmc_location {
+  uint16_t lcd;
+  char loc_class;
+  uint8_t type;
+  uint8_t subtype;
+  uint16_t area_ref;
+  uint16_t linear_ref;
+  uint16_t neg_offset;
+  uint16_t pos_offset;
+  const char* road_number;
+  const char* road_name;
+  const char* first_name;
+  const char* second_name;
+};
+
+struct tmc_location_index;
+
+/**
+ * Map a location table index file. The time taken is independent of the
+ * size of the tables, and the mapping is shared with every other process
+ * which opens the same file. Returns NULL on failure.
+ */
+struct tmc_location_index* open_tmc_location_index(const char* fname);
+
+void close_tmc_location_index(struct tmc_location_index* index);
+
+/**
+ * Find location |lcd| in location table |ltn|. Returns false if there is
+ * no such location.
+ */
+bool get_tmc_location(const struct tmc_location_index* index,
+                      uint8_t ltn,
+                      uint16_t lcd,
+                      struct tmc_location* location);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */